@@ -0,0 +1,102 @@
+#ifndef EXREAD_ACCUMULATOR_HPP
+#define EXREAD_ACCUMULATOR_HPP
+
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex
+#include <vector> // std::vector
+
+#include "bigint.hpp"
+
+namespace exread {
+
+    /*
+     *  Sum of many BigInts with deferred carries.
+     *
+     *  Every limb position keeps a 64 bit partial sum of the limbs added at
+     *  that position (carry-save form), separately for positive and negative
+     *  summands. Adding a number is a single pass over its limbs without any
+     *  carry propagation; carries are resolved by value(), or when the
+     *  partial sums could overflow otherwise.
+     */
+    class BigIntAccumulator
+    {
+        private:
+
+            using ulonglong = unsigned long long;
+            // partial sums, allocated like limbs
+            using sum_vector = std::vector<ulonglong, polymorphic_allocator<ulonglong>>;
+
+            // the partial sums absorb (with a wide margin) this many additions of full limbs after
+            // a carry resolution
+            static constexpr ulonglong max_pending = (std::numeric_limits<ulonglong>::max() >> mpn::limb_bits) / 2;
+
+            sum_vector positive; // positive[idx]: partial sum at limb position idx
+            sum_vector negative;
+            ulonglong pending; // additions since the last carry resolution
+
+            static void add_limbs(sum_vector& sums, const mpn::limb_t* limbs, size_t n);
+            static void add_sums(sum_vector& sums, const sum_vector& other);
+            // propagate the carries such that all partial sums are limbs
+            static void resolve(sum_vector& sums);
+            void resolve_if_full(ulonglong additions);
+            // the nonnegative BigInt with the limbs of the resolved partial sums
+            static BigInt from_sums(sum_vector sums, memory_resource* resource);
+
+        public:
+
+            // the partial sums are allocated from 'resource' (nullptr: the default resource)
+            explicit BigIntAccumulator(memory_resource* resource = nullptr)
+                : positive(sum_vector::allocator_type(resource)), negative(sum_vector::allocator_type(resource)), pending(0) {};
+
+            BigIntAccumulator& operator+= (const BigInt& n);
+            BigIntAccumulator& operator-= (const BigInt& n);
+            BigIntAccumulator& operator+= (const BigIntAccumulator& other);
+
+            // the sum of everything added so far
+            BigInt value(memory_resource* resource = nullptr) const;
+
+            void clear();
+
+    };
+
+    /*
+     *  BigIntAccumulator for concurrent additions from several threads.
+     *
+     *  Each thread adds into one of several shards, chosen by its id, such
+     *  that threads rarely contend for the same lock; value() merges the
+     *  shards.
+     */
+    class ShardedBigIntAccumulator
+    {
+        private:
+
+            struct shard
+            {
+                std::mutex mutex;
+                BigIntAccumulator sum;
+                char padding[64]; // keeps the mutexes of neighbouring shards on separate cache lines
+            };
+
+            const size_t shard_count;
+            std::unique_ptr<shard[]> shards;
+
+            shard& this_thread_shard();
+
+        public:
+
+            // 'count' shards; 0 selects the number of hardware threads
+            explicit ShardedBigIntAccumulator(size_t count = 0);
+
+            ShardedBigIntAccumulator& operator+= (const BigInt& n);
+            ShardedBigIntAccumulator& operator-= (const BigInt& n);
+
+            // the sum of everything added so far; concurrent additions may or may not be included
+            BigInt value(memory_resource* resource = nullptr) const;
+
+            void clear();
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef EXREAD_BARRETT_HPP
+#define EXREAD_BARRETT_HPP
+
+#include "bigint.hpp"
+
+namespace exread {
+
+    /*
+     *  Barrett reduction modulo a fixed positive modulus m of k limbs.
+     *
+     *  With b the limb base, mu = floor(b^2k / m) is computed once; afterwards
+     *  any 0 <= x < b^2k (in particular any product of two residues) is reduced
+     *  with two multiplications and no division. Unlike Montgomery arithmetic,
+     *  Barrett reduction works for even moduli and needs no change of form.
+     */
+    class BarrettContext
+    {
+        private:
+
+            BigInt m; // the modulus
+            size_t k; // number of limbs of the modulus
+            BigInt mu; // floor(b^2k / m)
+
+        public:
+
+            // throws std::invalid_argument unless 'modulus' is positive
+            explicit BarrettContext(const BigInt& modulus);
+
+            const BigInt& modulus() const { return m; }
+
+            // x mod m in [0, m); falls back to operator% if x is negative or x >= b^2k
+            BigInt reduce(const BigInt& x) const;
+
+            // a * b mod m and a^2 mod m for residues 0 <= a, b < m
+            BigInt mul(const BigInt& a, const BigInt& b) const { return reduce(a * b); }
+            BigInt sqr(const BigInt& a) const { return reduce(a * a); }
+
+    };
+
+}
+
+#endif
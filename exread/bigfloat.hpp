@@ -0,0 +1,131 @@
+#ifndef EXREAD_BIGFLOAT_HPP
+#define EXREAD_BIGFLOAT_HPP
+
+#include "bigint.hpp"
+
+namespace exread {
+
+    // rounding of results that are not representable in the target precision
+    enum class RoundingMode
+    {
+        nearest_even, // to the nearest representable value, ties to an even mantissa
+        toward_zero,
+        upward, // toward positive infinity
+        downward // toward negative infinity
+    };
+
+    /*
+     *  Binary floating point number mantissa * 2^exponent with a BigInt
+     *  mantissa of at most precision() bits, in the spirit of MPFR.
+     *
+     *  Every operation returns the exact result rounded correctly to the
+     *  requested precision. The mantissa is kept odd (or zero), which makes
+     *  the representation unique; there are no infinities, NaNs or signed
+     *  zeros.
+     *
+     *  Operands of more than the target precision (plus guard bits) are
+     *  truncated before multiplying, dividing or taking the square root, and
+     *  the result is computed for both ends of the truncation interval; only
+     *  if they round differently, the exact operands are used. The cost thus
+     *  follows the target precision rather than the operand sizes.
+     */
+    class BigFloat
+    {
+        private:
+
+            BigInt mant; // odd or zero
+            long exp;
+            size_t prec;
+
+            // private constructor from parts; does not round
+            BigFloat(BigInt mant, long exp, size_t prec) : mant(std::move(mant)), exp(exp), prec(prec) {};
+
+            // (-1)^negative * (magnitude + s) * 2^exponent rounded to 'prec' bits, where the sticky
+            // s is 0 if 'sticky' is false and in (0, 1) otherwise
+            static BigFloat round(bool negative, BigInt magnitude, long exponent, bool sticky, size_t prec, RoundingMode rnd);
+
+            // correctly rounded result for a value in [lo, hi] * 2^exponent if both ends round
+            // alike; returns false otherwise
+            static bool round_interval(BigFloat& res, bool negative, const BigInt& lo, const BigInt& hi, long exponent, size_t prec, RoundingMode rnd);
+
+            // magnitude of the mantissa truncated to at most 'bits' bits, with the exponent
+            // adjusted; returns whether any set bit was cut off
+            bool truncated(BigInt& magnitude, long& exponent, size_t bits) const;
+
+        public:
+
+            static constexpr size_t default_precision = 53;
+
+            /*
+             *  Constructors; throw std::invalid_argument for a zero precision
+             */
+            // zero
+            BigFloat() : mant(), exp(0), prec(default_precision) {};
+
+            // n rounded to 'prec' bits
+            BigFloat(const BigInt& n, size_t prec = default_precision, RoundingMode rnd = RoundingMode::nearest_even);
+
+            // d rounded to 'prec' bits (exact for prec >= 53); throws std::invalid_argument for
+            // infinities and NaN
+            explicit BigFloat(double d, size_t prec = default_precision, RoundingMode rnd = RoundingMode::nearest_even);
+
+            // this value rounded to 'prec' bits
+            BigFloat rounded(size_t prec, RoundingMode rnd = RoundingMode::nearest_even) const;
+
+            /*
+             *  access; the value is mantissa() * 2^exponent()
+             */
+            const BigInt& mantissa() const { return mant; }
+            long exponent() const { return exp; }
+            size_t precision() const { return prec; }
+            bool is_zero() const { return mant.size() == 0; }
+            bool is_negative() const { return mant.is_negative(); }
+
+            /*
+             *  comparison operators
+             */
+            // three-way comparison of the values; returns -1, 0 or 1
+            int compare(const BigFloat& other) const;
+
+            bool operator== (const BigFloat& other) const { return compare(other) == 0; }
+            bool operator!= (const BigFloat& other) const { return compare(other) != 0; }
+            bool operator>= (const BigFloat& other) const { return compare(other) >= 0; }
+            bool operator<  (const BigFloat& other) const { return compare(other) <  0; }
+            bool operator<= (const BigFloat& other) const { return compare(other) <= 0; }
+            bool operator>  (const BigFloat& other) const { return compare(other) >  0; }
+
+            /*
+             *  arithmetic with explicit precision and rounding
+             */
+            friend BigFloat add(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd);
+            friend BigFloat sub(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd);
+            friend BigFloat mul(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd);
+            // throws std::invalid_argument for y == 0
+            friend BigFloat div(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd);
+            // throws std::invalid_argument for negative x
+            friend BigFloat sqrt(const BigFloat& x, size_t prec, RoundingMode rnd);
+            // x * 2^e with the precision of x; exact
+            friend BigFloat ldexp(const BigFloat& x, long e) { return {x.mant, x.is_zero() ? 0 : x.exp + e, x.prec}; }
+
+            /*
+             *  arithmetic operators; round to nearest with the larger precision of the operands
+             */
+            BigFloat operator+() const { return *this; };
+            BigFloat operator-() const { return {-mant, exp, prec}; };
+
+            friend BigFloat operator+ (const BigFloat& x, const BigFloat& y);
+            friend BigFloat operator- (const BigFloat& x, const BigFloat& y);
+            friend BigFloat operator* (const BigFloat& x, const BigFloat& y);
+            friend BigFloat operator/ (const BigFloat& x, const BigFloat& y);
+
+    };
+
+    BigFloat add(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd = RoundingMode::nearest_even);
+    BigFloat sub(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd = RoundingMode::nearest_even);
+    BigFloat mul(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd = RoundingMode::nearest_even);
+    BigFloat div(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd = RoundingMode::nearest_even);
+    BigFloat sqrt(const BigFloat& x, size_t prec, RoundingMode rnd = RoundingMode::nearest_even);
+
+}
+
+#endif
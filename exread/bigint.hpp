@@ -1,33 +1,47 @@
-#include <algorithm> // std::max
+#ifndef EXREAD_BIGINT_HPP
+#define EXREAD_BIGINT_HPP
+
+#include <algorithm> // std::copy, std::max
 #include <cassert> // assert
 #include <cstdio> // std::size_t
 #include <limits> // std::numeric_limits
 #include <stdexcept> // std::invalid_argument
+#include <string> // std::string
 #include <type_traits> // std::enable_if
 #include <utility> // std::move
 #include <vector> // std::vector
 
+#include "memory.hpp"
+#include "mpn.hpp"
+
 namespace exread {
 
     using std::size_t;
 
+    // storage for the limbs of a BigInt
+    using limb_vector = std::vector<mpn::limb_t, polymorphic_allocator<mpn::limb_t>>;
+
     class BigInt
     {
         private:
 
-            using base_int = unsigned int;
+            using base_int = mpn::limb_t;
             static constexpr int base_radix = std::numeric_limits<base_int>::radix;
             static constexpr int base_digits = std::numeric_limits<base_int>::digits;
-            static constexpr int half_base_digits = base_digits / 2;
-            static constexpr base_int leading_mask = (1 << half_base_digits) - 1;
+            static constexpr int half_base_digits = mpn::limb_bits;
+            static constexpr base_int leading_mask = mpn::limb_mask;
             static_assert(half_base_digits > 0, "BigInt must have an integral type with at least 2 digits as base_int.");
 
             bool neg; // sign bit
-            std::vector<base_int> digits;
+            limb_vector digits;
 
             // private constructors from sign and digits
-            BigInt(const bool& neg, const std::vector<base_int>& digits) : neg(digits.size()>0?neg:false), digits(digits) {}; // copy
-            BigInt(const bool& neg, std::vector<base_int>&& digits) : neg(digits.size()>0?neg:false), digits(std::move(digits)) {}; // move
+            BigInt(const bool& neg, const limb_vector& digits) : neg(digits.size()>0?neg:false), digits(digits) {}; // copy
+            BigInt(const bool& neg, limb_vector&& digits) : neg(digits.size()>0?neg:false), digits(std::move(digits)) {}; // move
+
+            // apply the limbwise operation 'op' to the two's complement representations
+            template<typename Op>
+            BigInt& bitwise_assign(const BigInt& other, Op op);
 
         public:
 
@@ -38,9 +52,15 @@ namespace exread {
             // default
             BigInt() : neg(false), digits() {};
 
+            // zero with limbs allocated from 'resource'
+            explicit BigInt(memory_resource* resource) : neg(false), digits(limb_vector::allocator_type(resource)) {};
+
+            // copy with limbs allocated from 'resource'
+            BigInt(const BigInt& other, memory_resource* resource) : neg(other.neg), digits(other.digits, limb_vector::allocator_type(resource)) {};
+
             // from builtin integral type
             template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
-            BigInt(T n) : neg(n<0)
+            BigInt(T n, memory_resource* resource = nullptr) : neg(n<0), digits(limb_vector::allocator_type(resource))
             {
                 static_assert(std::numeric_limits<T>::radix == base_radix, "BigInt must be constructed from integral type with the same radix as the base_int.");
 
@@ -59,39 +79,48 @@ namespace exread {
 
             };
 
-            // from string
-            BigInt(const std::string& n) : neg(n.size()>0 ? n[0] == '-' : false)
-            {
-                BigInt res, base10 = 1;
+            // from string of decimal digits with optional leading minus
+            BigInt(const std::string& n, memory_resource* resource = nullptr);
 
-                for (auto digit = n.crbegin(); digit != (neg ? n.crend()-1 : n.crend()); ++digit)
-                {
-                    char tmp = *digit - 48;
-                    if (tmp < 0 || tmp > 9)
-                        throw std::invalid_argument("BigInt(\"" + n + "\")");
-                    res = res + tmp * base10;
-                    base10 = base10 * 10;
-                }
+        /*
+         *  low-level access to the limbs of the magnitude (see exread/mpn.hpp)
+         */
+        bool is_negative() const { return neg; }
+        // resource the limbs are allocated from
+        memory_resource* resource() const { return digits.get_allocator().resource(); }
+        size_t size() const { return digits.size(); }
+        const mpn::limb_t* limbs_read() const { return digits.data(); }
+        // resize the magnitude to 'n' limbs (keeping the low limbs) and return it for writing
+        mpn::limb_t* limbs_write(size_t n) { digits.resize(n); return digits.data(); }
+        // finish writing: strip leading zeros of the first 'n' limbs and set the sign
+        void limbs_finish(size_t n, bool negative = false)
+        {
+            digits.resize(mpn::normalized_size(digits.data(), n));
+            neg = digits.empty() ? false : negative;
+        }
 
-                this->digits = std::move(res.digits);
-            };
 
         /*
          *  comparison operators
          */
-        bool operator== (const BigInt& other) const;
-        bool operator!= (const BigInt& other) const { return !(*this == other); }
-        bool operator>= (const BigInt& other) const;
-        bool operator<  (const BigInt& other) const { return !(*this >= other); }
-        bool operator<= (const BigInt& other) const { return  ( other >= *this); }
-        bool operator>  (const BigInt& other) const { return !(*this <= other); }
+        // three-way comparison; returns -1, 0 or 1
+        int compare(const BigInt& other) const;
+        // three-way comparison of the absolute values; returns -1, 0 or 1
+        int cmp_abs(const BigInt& other) const;
+
+        bool operator== (const BigInt& other) const { return compare(other) == 0; }
+        bool operator!= (const BigInt& other) const { return compare(other) != 0; }
+        bool operator>= (const BigInt& other) const { return compare(other) >= 0; }
+        bool operator<  (const BigInt& other) const { return compare(other) <  0; }
+        bool operator<= (const BigInt& other) const { return compare(other) <= 0; }
+        bool operator>  (const BigInt& other) const { return compare(other) >  0; }
 
 
         /*
          *  unary arithmetic operators
          */
-        BigInt operator+() const {  return *this;  };
-        BigInt operator-() const {  return {!neg, digits};  };
+        BigInt operator+() const {  return {*this, resource()};  };
+        BigInt operator-() const {  return {!neg, limb_vector(digits, digits.get_allocator())};  };
 
         /*
          *  binary arithmetic operators
@@ -99,8 +128,188 @@ namespace exread {
         friend BigInt operator+ (const BigInt& n1, const BigInt& n2);
         friend BigInt operator- (const BigInt& n1, const BigInt& n2);
         friend BigInt operator* (const BigInt& n1, const BigInt& n2);
-        friend BigInt operator/ (const BigInt& n1, const BigInt& n2);
+        friend BigInt operator/ (const BigInt& n1, const BigInt& n2); // truncates towards zero
+        friend BigInt operator% (const BigInt& n1, const BigInt& n2); // has the sign of n1
+
+
+        /*
+         *  shift operators; operator>> rounds towards negative infinity
+         */
+        BigInt& operator<<= (size_t count);
+        BigInt& operator>>= (size_t count);
+        friend BigInt operator<< (const BigInt& n, size_t count);
+        friend BigInt operator>> (const BigInt& n, size_t count);
+
+
+        /*
+         *  bit queries; bit_length, popcount and countr_zero refer to the
+         *  absolute value, test_bit, set_bit and clear_bit to the two's
+         *  complement representation (like the bitwise operators)
+         */
+        // number of bits of the absolute value; 0 for zero
+        size_t bit_length() const;
+        // number of set bits of the absolute value
+        size_t popcount() const;
+        // number of trailing zero bits; 0 for zero
+        size_t countr_zero() const;
+        bool test_bit(size_t idx) const;
+        BigInt& set_bit(size_t idx);
+        BigInt& clear_bit(size_t idx);
+
+
+        /*
+         *  conversion
+         */
+        // nearest double, ties to even, and +-infinity beyond its range; reads only the
+        // top 64 bits and whether any bit below them is set
+        double to_double() const;
+
+
+        /*
+         *  bitwise operators; negative numbers behave like infinitely sign
+         *  extended two's complement numbers, i.e. ~n == -n - 1
+         */
+        BigInt operator~() const;
+        BigInt& operator&= (const BigInt& other);
+        BigInt& operator|= (const BigInt& other);
+        BigInt& operator^= (const BigInt& other);
+        friend BigInt operator& (const BigInt& n1, const BigInt& n2);
+        friend BigInt operator| (const BigInt& n1, const BigInt& n2);
+        friend BigInt operator^ (const BigInt& n1, const BigInt& n2);
 
     };
 
+    // base^exponent with pow(0, 0) == 1; call with a BigInt base, builtin arguments select std::pow
+    BigInt pow(const BigInt& base, unsigned exponent);
+
+    // acc = acc + a*b and acc = acc - a*b, accumulating the product directly into the
+    // limbs of 'acc' instead of forming it as a separate BigInt
+    void addmul(BigInt& acc, const BigInt& a, const BigInt& b);
+    void submul(BigInt& acc, const BigInt& a, const BigInt& b);
+
+    namespace addmul_detail {
+
+        // acc = acc + a*b for b = (negative ? -magnitude : magnitude)
+        void addmul_word(BigInt& acc, const BigInt& a, unsigned long long magnitude, bool negative);
+
+        template<typename T>
+        unsigned long long magnitude(T b) { return b < 0 ? 0ull - static_cast<unsigned long long>(b) : static_cast<unsigned long long>(b); }
+
+    }
+
+    // as above with a builtin integer 'b', whose limbs are multiplied in place row by row
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    void addmul(BigInt& acc, const BigInt& a, T b) { addmul_detail::addmul_word(acc, a, addmul_detail::magnitude(b), b < 0); }
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    void submul(BigInt& acc, const BigInt& a, T b) { addmul_detail::addmul_word(acc, a, addmul_detail::magnitude(b), !(b < 0)); }
+
+
+    /*
+     *  compile-time evaluation of integer literals
+     */
+    namespace literal_detail {
+
+        // limbs of a literal, least significant limb first
+        template<size_t N>
+        struct limb_table
+        {
+            mpn::limb_t limbs[N];
+            size_t size;
+        };
+
+        // 16 for characters that are no digit in any base, like '.', 'e', 'p' or a sign
+        constexpr unsigned digit_value(char c)
+        {
+            return (c >= '0' && c <= '9') ? unsigned(c - '0') :
+                   (c >= 'a' && c <= 'f') ? unsigned(c - 'a' + 10) :
+                   (c >= 'A' && c <= 'F') ? unsigned(c - 'A' + 10) : 16;
+        }
+
+        struct literal_prefix
+        {
+            unsigned base;
+            size_t length;
+        };
+
+        // the base of a decimal, hexadecimal (0x), binary (0b) or octal (0) integer literal
+        constexpr literal_prefix prefix(const char* chars, size_t length)
+        {
+            if (length > 2 && chars[0] == '0' && (chars[1] == 'x' || chars[1] == 'X'))
+                return {16, 2};
+            if (length > 2 && chars[0] == '0' && (chars[1] == 'b' || chars[1] == 'B'))
+                return {2, 2};
+            if (length > 1 && chars[0] == '0')
+                return {8, 1};
+            return {10, 0};
+        }
+
+        // whether all characters after the prefix are digits of the base or separators;
+        // false for floating literals like 1.5 or 1e5, which also reach a literal operator template
+        template<char... Cs>
+        constexpr bool is_integer()
+        {
+            constexpr size_t length = sizeof...(Cs);
+            constexpr char chars[length] = {Cs...};
+
+            const literal_prefix p = prefix(chars, length);
+            for (size_t pos = p.length; pos < length; ++pos)
+                if (chars[pos] != '\'' && digit_value(chars[pos]) >= p.base)
+                    return false;
+            return true;
+        }
+
+        // parse the characters of an integer literal with is_integer<Cs...>();
+        // a digit takes at most 4 bits, which bounds the number of limbs
+        template<char... Cs>
+        constexpr limb_table<sizeof...(Cs) * 4 / mpn::limb_bits + 1> parse()
+        {
+            constexpr size_t length = sizeof...(Cs);
+            constexpr char chars[length] = {Cs...};
+
+            const literal_prefix p = prefix(chars, length);
+            const unsigned base = p.base;
+            size_t pos = p.length;
+
+            limb_table<length * 4 / mpn::limb_bits + 1> table{};
+            for ( ; pos < length; ++pos)
+            {
+                if (chars[pos] == '\'') // digit separator
+                    continue;
+
+                // table = table * base + digit
+                mpn::limb_t carry = digit_value(chars[pos]);
+                for (size_t idx = 0; idx < table.size; ++idx)
+                {
+                    carry += table.limbs[idx] * base;
+                    table.limbs[idx] = carry & mpn::limb_mask;
+                    carry >>= mpn::limb_bits;
+                }
+                if (carry)
+                    table.limbs[table.size++] = carry;
+            }
+            return table;
+        }
+
+    }
+
+    inline namespace literals {
+
+        // BigInt literal, e.g. 12345678901234567890_big; the limbs are computed at
+        // compile time and stored in a static table, which is copied at runtime
+        template<char... Cs>
+        BigInt operator"" _big()
+        {
+            static_assert(literal_detail::is_integer<Cs...>(), "_big: not an integer literal of its base");
+            static constexpr auto table = literal_detail::parse<Cs...>();
+
+            BigInt res;
+            std::copy(table.limbs, table.limbs + table.size, res.limbs_write(table.size));
+            res.limbs_finish(table.size);
+            return res;
+        }
+
+    }
+
 }
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef EXREAD_COMBINATORICS_HPP
+#define EXREAD_COMBINATORICS_HPP
+
+#include "bigint.hpp"
+
+namespace exread {
+
+    /*
+     *  combinatorial functions
+     *
+     *  All results are assembled from their prime factorizations, which are
+     *  multiplied in balanced product trees: the large multiplications then
+     *  have operands of similar size and profit from fast multiplication.
+     */
+    // n!
+    BigInt factorial(unsigned long n);
+
+    // n choose k; zero for k > n
+    BigInt binomial(unsigned long n, unsigned long k);
+
+    // product of all primes <= n
+    BigInt primorial(unsigned long n);
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef EXREAD_DECIMAL_HPP
+#define EXREAD_DECIMAL_HPP
+
+#include <string> // std::string
+
+#include "bigint.hpp"
+#include "rational.hpp"
+
+namespace exread {
+
+    /*
+     *  exact reading of decimal numbers
+     *
+     *  Decimal fractions in fixed or scientific notation, like
+     *  "-123.4500e-17", are read without any floating point: the digits on
+     *  both sides of the decimal point are parsed as one integer by the
+     *  chunked parser of BigInt(const std::string&), and the position of the
+     *  decimal point is folded into the power of ten.
+     *
+     *  Accepted is an optional sign, digits with at most one decimal point
+     *  (and at least one digit), and optionally 'e' or 'E' followed by an
+     *  optionally signed decimal exponent. Anything else, including white
+     *  space, throws std::invalid_argument.
+     */
+    // significand * 10^exponent; the significand has no trailing zero digit, and the
+    // exponent of zero is zero
+    struct DecimalNumber
+    {
+        BigInt significand;
+        long exponent;
+    };
+
+    // also throws std::invalid_argument for exponents beyond a quarter of the range of long
+    DecimalNumber read_decimal(const std::string& s, memory_resource* resource = nullptr);
+
+    // the value of d in lowest terms; throws std::invalid_argument if |d.exponent| exceeds
+    // the range of unsigned
+    Rational to_rational(const DecimalNumber& d);
+
+    // the value of the decimal number s in lowest terms
+    Rational read_rational(const std::string& s);
+
+    // the decimal number s rounded to the nearest double, ties to even, with a signed zero or
+    // infinity outside the range of double (where also huge exponents are accepted); exact
+    // big number arithmetic is needed only for values very close to the midpoint of two doubles
+    double read_double(const std::string& s);
+
+}
+
+#endif
@@ -0,0 +1,370 @@
+#ifndef EXREAD_FIXEDINT_HPP
+#define EXREAD_FIXEDINT_HPP
+
+#include <array> // std::array
+#include <limits> // std::numeric_limits
+#include <stdexcept> // std::invalid_argument, std::out_of_range
+#include <string> // std::string
+#include <type_traits> // std::conditional, std::enable_if, std::is_integral, std::is_signed
+
+#include "bigint.hpp"
+#include "mpn.hpp"
+
+namespace exread {
+
+    /*
+     *  helpers on inline limb arrays of compile-time length N; they call the
+     *  inline mpn kernels with constant sizes, which the compiler unrolls
+     */
+    namespace fixed_detail {
+
+        template<size_t N>
+        using limb_array = std::array<mpn::limb_t, N>;
+
+        // two's complement of 'n' modulo b^N
+        template<size_t N, typename T>
+        limb_array<N> from_integral(T n)
+        {
+            // sign extend to the widest builtin type
+            using wide = typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type;
+            constexpr int wide_digits = std::numeric_limits<unsigned long long>::digits;
+            unsigned long long u = static_cast<unsigned long long>(static_cast<wide>(n));
+            const bool negative = std::is_signed<T>::value && (u >> (wide_digits - 1));
+            const mpn::limb_t fill = negative ? mpn::limb_mask : 0;
+
+            limb_array<N> res;
+            constexpr size_t integral_limbs = wide_digits / mpn::limb_bits;
+            for (size_t idx = 0; idx < N; ++idx)
+            {
+                if (idx < integral_limbs)
+                {
+                    res[idx] = u & mpn::limb_mask;
+                    u >>= mpn::limb_bits;
+                } else {
+                    res[idx] = fill;
+                }
+            }
+            return res;
+        }
+
+        template<size_t N>
+        limb_array<N> negate(const limb_array<N>& a)
+        {
+            limb_array<N> res;
+            for (size_t idx = 0; idx < N; ++idx)
+                res[idx] = ~a[idx] & mpn::limb_mask;
+            mpn::add_1(res.data(), res.data(), N, 1);
+            return res;
+        }
+
+        // low N limbs of a * b
+        template<size_t N>
+        limb_array<N> mul_low(const limb_array<N>& a, const limb_array<N>& b)
+        {
+            limb_array<N> res{};
+            for (size_t idx = 0; idx < N; ++idx)
+                if (b[idx] != 0)
+                    mpn::addmul_1(res.data() + idx, a.data(), N - idx, b[idx]);
+            return res;
+        }
+
+        // unsigned division with remainder
+        template<size_t N>
+        void divrem(limb_array<N>& q, limb_array<N>& r, const limb_array<N>& a, const limb_array<N>& b, const char* name)
+        {
+            const size_t bn = mpn::normalized_size(b.data(), N);
+            if (bn == 0)
+                throw std::invalid_argument(std::string("Division by ") + name + "(0)");
+            const size_t an = mpn::normalized_size(a.data(), N);
+
+            q.fill(0);
+            r.fill(0);
+            if (an < bn)
+            {
+                r = a;
+                return;
+            }
+
+            std::array<mpn::limb_t, 2*N + 1> scratch;
+            mpn::divrem(q.data(), r.data(), a.data(), an, b.data(), bn, scratch.data());
+        }
+
+        template<size_t N>
+        limb_array<N> shift_left(const limb_array<N>& a, size_t count)
+        {
+            limb_array<N> res{};
+            const size_t limbs = count / mpn::limb_bits;
+            const int bits = count % mpn::limb_bits;
+            if (limbs >= N)
+                return res;
+
+            if (bits)
+                mpn::lshift(res.data() + limbs, a.data(), N - limbs, bits);
+            else
+                for (size_t idx = limbs; idx < N; ++idx)
+                    res[idx] = a[idx - limbs];
+            return res;
+        }
+
+        // 'fill' is shifted in at the top (0 or limb_mask)
+        template<size_t N>
+        limb_array<N> shift_right(const limb_array<N>& a, size_t count, mpn::limb_t fill)
+        {
+            limb_array<N> res;
+            res.fill(fill);
+            const size_t limbs = count / mpn::limb_bits;
+            const int bits = count % mpn::limb_bits;
+            if (limbs >= N)
+                return res;
+
+            if (bits)
+            {
+                mpn::rshift(res.data(), a.data() + limbs, N - limbs, bits);
+                res[N - limbs - 1] |= (fill << (mpn::limb_bits - bits)) & mpn::limb_mask;
+            } else {
+                for (size_t idx = 0; idx < N - limbs; ++idx)
+                    res[idx] = a[idx + limbs];
+            }
+            return res;
+        }
+
+    }
+
+
+    /*
+     *  FixedUInt<Bits>: unsigned integer of 'Bits' bits with inline storage;
+     *  arithmetic wraps around modulo 2^Bits like builtin unsigned types
+     */
+    template<size_t Bits>
+    class FixedUInt
+    {
+        static_assert(Bits > 0 && Bits % mpn::limb_bits == 0, "FixedUInt requires a positive multiple of mpn::limb_bits as number of bits.");
+
+        public:
+
+            static constexpr size_t num_limbs = Bits / mpn::limb_bits;
+            using limb_array = fixed_detail::limb_array<num_limbs>;
+
+        private:
+
+            limb_array limbs; // least significant limb first
+
+        public:
+
+            /*
+             *  Constructors
+             */
+
+            // default
+            FixedUInt() : limbs() {};
+
+            // from builtin integral type (negative numbers wrap around)
+            template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+            FixedUInt(T n) : limbs(fixed_detail::from_integral<num_limbs>(n)) {};
+
+            // from BigInt; throws std::out_of_range unless 0 <= n < 2^Bits
+            explicit FixedUInt(const BigInt& n) : limbs()
+            {
+                if (n.is_negative() || n.size() > num_limbs)
+                    throw std::out_of_range("FixedUInt: BigInt out of range");
+                for (size_t idx = 0; idx < n.size(); ++idx)
+                    limbs[idx] = n.limbs_read()[idx];
+            };
+
+            // from limbs
+            static FixedUInt from_limbs(const limb_array& limbs) { FixedUInt res; res.limbs = limbs; return res; }
+
+            /*
+             *  conversion
+             */
+            BigInt to_bigint() const
+            {
+                BigInt res;
+                mpn::limb_t* p = res.limbs_write(num_limbs);
+                for (size_t idx = 0; idx < num_limbs; ++idx)
+                    p[idx] = limbs[idx];
+                res.limbs_finish(num_limbs);
+                return res;
+            }
+
+            const limb_array& limbs_read() const { return limbs; }
+
+        /*
+         *  comparison operators
+         */
+        int compare(const FixedUInt& other) const { return mpn::cmp(limbs.data(), other.limbs.data(), num_limbs); }
+
+        bool operator== (const FixedUInt& other) const { return limbs == other.limbs; }
+        bool operator!= (const FixedUInt& other) const { return limbs != other.limbs; }
+        bool operator>= (const FixedUInt& other) const { return compare(other) >= 0; }
+        bool operator<  (const FixedUInt& other) const { return compare(other) <  0; }
+        bool operator<= (const FixedUInt& other) const { return compare(other) <= 0; }
+        bool operator>  (const FixedUInt& other) const { return compare(other) >  0; }
+
+        /*
+         *  unary arithmetic operators
+         */
+        FixedUInt operator+() const { return *this; }
+        FixedUInt operator-() const { return from_limbs(fixed_detail::negate(limbs)); }
+
+        /*
+         *  arithmetic assignment operators
+         */
+        FixedUInt& operator+= (const FixedUInt& other) { mpn::add_n(limbs.data(), limbs.data(), other.limbs.data(), num_limbs); return *this; }
+        FixedUInt& operator-= (const FixedUInt& other) { mpn::sub_n(limbs.data(), limbs.data(), other.limbs.data(), num_limbs); return *this; }
+        FixedUInt& operator*= (const FixedUInt& other) { limbs = fixed_detail::mul_low(limbs, other.limbs); return *this; }
+        FixedUInt& operator/= (const FixedUInt& other) { limb_array r; fixed_detail::divrem(limbs, r, limb_array(limbs), other.limbs, "FixedUInt"); return *this; }
+        FixedUInt& operator%= (const FixedUInt& other) { limb_array q; fixed_detail::divrem(q, limbs, limb_array(limbs), other.limbs, "FixedUInt"); return *this; }
+        FixedUInt& operator<<= (size_t count) { limbs = fixed_detail::shift_left(limbs, count); return *this; }
+        FixedUInt& operator>>= (size_t count) { limbs = fixed_detail::shift_right(limbs, count, 0); return *this; }
+
+        /*
+         *  binary arithmetic operators
+         */
+        friend FixedUInt operator+ (FixedUInt n1, const FixedUInt& n2) { return n1 += n2; }
+        friend FixedUInt operator- (FixedUInt n1, const FixedUInt& n2) { return n1 -= n2; }
+        friend FixedUInt operator* (FixedUInt n1, const FixedUInt& n2) { return n1 *= n2; }
+        friend FixedUInt operator/ (FixedUInt n1, const FixedUInt& n2) { return n1 /= n2; }
+        friend FixedUInt operator% (FixedUInt n1, const FixedUInt& n2) { return n1 %= n2; }
+        friend FixedUInt operator<< (FixedUInt n, size_t count) { return n <<= count; }
+        friend FixedUInt operator>> (FixedUInt n, size_t count) { return n >>= count; }
+
+    };
+
+
+    /*
+     *  FixedInt<Bits>: signed integer of 'Bits' bits in two's complement with
+     *  inline storage; arithmetic wraps around modulo 2^Bits, division
+     *  truncates towards zero
+     */
+    template<size_t Bits>
+    class FixedInt
+    {
+        static_assert(Bits > 0 && Bits % mpn::limb_bits == 0, "FixedInt requires a positive multiple of mpn::limb_bits as number of bits.");
+
+        public:
+
+            static constexpr size_t num_limbs = Bits / mpn::limb_bits;
+            using limb_array = fixed_detail::limb_array<num_limbs>;
+
+        private:
+
+            limb_array limbs; // two's complement, least significant limb first
+
+            static constexpr mpn::limb_t sign_mask = mpn::limb_t(1) << (mpn::limb_bits - 1);
+
+            // absolute value as unsigned limbs (exact also for the most negative number)
+            limb_array magnitude() const { return is_negative() ? fixed_detail::negate(limbs) : limbs; }
+
+        public:
+
+            /*
+             *  Constructors
+             */
+
+            // default
+            FixedInt() : limbs() {};
+
+            // from builtin integral type
+            template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+            FixedInt(T n) : limbs(fixed_detail::from_integral<num_limbs>(n)) {};
+
+            // from BigInt; throws std::out_of_range unless -2^(Bits-1) <= n < 2^(Bits-1)
+            explicit FixedInt(const BigInt& n) : limbs()
+            {
+                if (n.size() > num_limbs)
+                    throw std::out_of_range("FixedInt: BigInt out of range");
+                for (size_t idx = 0; idx < n.size(); ++idx)
+                    limbs[idx] = n.limbs_read()[idx];
+                if (n.is_negative())
+                    limbs = fixed_detail::negate(limbs);
+                if (n.size() > 0 && is_negative() != n.is_negative())
+                    throw std::out_of_range("FixedInt: BigInt out of range");
+            };
+
+            // from limbs in two's complement
+            static FixedInt from_limbs(const limb_array& limbs) { FixedInt res; res.limbs = limbs; return res; }
+
+            /*
+             *  conversion
+             */
+            BigInt to_bigint() const
+            {
+                const limb_array abs = magnitude();
+                BigInt res;
+                mpn::limb_t* p = res.limbs_write(num_limbs);
+                for (size_t idx = 0; idx < num_limbs; ++idx)
+                    p[idx] = abs[idx];
+                res.limbs_finish(num_limbs, is_negative());
+                return res;
+            }
+
+            const limb_array& limbs_read() const { return limbs; }
+
+            bool is_negative() const { return limbs[num_limbs-1] & sign_mask; }
+
+        /*
+         *  comparison operators
+         */
+        int compare(const FixedInt& other) const
+        {
+            if (is_negative() != other.is_negative())
+                return is_negative() ? -1 : 1;
+            // equal signs: two's complement preserves the unsigned order
+            return mpn::cmp(limbs.data(), other.limbs.data(), num_limbs);
+        }
+
+        bool operator== (const FixedInt& other) const { return limbs == other.limbs; }
+        bool operator!= (const FixedInt& other) const { return limbs != other.limbs; }
+        bool operator>= (const FixedInt& other) const { return compare(other) >= 0; }
+        bool operator<  (const FixedInt& other) const { return compare(other) <  0; }
+        bool operator<= (const FixedInt& other) const { return compare(other) <= 0; }
+        bool operator>  (const FixedInt& other) const { return compare(other) >  0; }
+
+        /*
+         *  unary arithmetic operators
+         */
+        FixedInt operator+() const { return *this; }
+        FixedInt operator-() const { return from_limbs(fixed_detail::negate(limbs)); }
+
+        /*
+         *  arithmetic assignment operators
+         */
+        FixedInt& operator+= (const FixedInt& other) { mpn::add_n(limbs.data(), limbs.data(), other.limbs.data(), num_limbs); return *this; }
+        FixedInt& operator-= (const FixedInt& other) { mpn::sub_n(limbs.data(), limbs.data(), other.limbs.data(), num_limbs); return *this; }
+        FixedInt& operator*= (const FixedInt& other) { limbs = fixed_detail::mul_low(limbs, other.limbs); return *this; }
+        FixedInt& operator/= (const FixedInt& other)
+        {
+            limb_array q, r;
+            fixed_detail::divrem(q, r, magnitude(), other.magnitude(), "FixedInt");
+            limbs = (is_negative() != other.is_negative()) ? fixed_detail::negate(q) : q;
+            return *this;
+        }
+        FixedInt& operator%= (const FixedInt& other)
+        {
+            // the remainder has the sign of the dividend
+            limb_array q, r;
+            fixed_detail::divrem(q, r, magnitude(), other.magnitude(), "FixedInt");
+            limbs = is_negative() ? fixed_detail::negate(r) : r;
+            return *this;
+        }
+        FixedInt& operator<<= (size_t count) { limbs = fixed_detail::shift_left(limbs, count); return *this; }
+        // arithmetic shift (rounds towards negative infinity)
+        FixedInt& operator>>= (size_t count) { limbs = fixed_detail::shift_right(limbs, count, is_negative() ? mpn::limb_mask : 0); return *this; }
+
+        /*
+         *  binary arithmetic operators
+         */
+        friend FixedInt operator+ (FixedInt n1, const FixedInt& n2) { return n1 += n2; }
+        friend FixedInt operator- (FixedInt n1, const FixedInt& n2) { return n1 -= n2; }
+        friend FixedInt operator* (FixedInt n1, const FixedInt& n2) { return n1 *= n2; }
+        friend FixedInt operator/ (FixedInt n1, const FixedInt& n2) { return n1 /= n2; }
+        friend FixedInt operator% (FixedInt n1, const FixedInt& n2) { return n1 %= n2; }
+        friend FixedInt operator<< (FixedInt n, size_t count) { return n <<= count; }
+        friend FixedInt operator>> (FixedInt n, size_t count) { return n >>= count; }
+
+    };
+
+}
+
+#endif
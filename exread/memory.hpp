@@ -0,0 +1,211 @@
+#ifndef EXREAD_MEMORY_HPP
+#define EXREAD_MEMORY_HPP
+
+#include <cstddef> // std::max_align_t
+#include <cstdio> // std::size_t
+
+namespace exread {
+
+    using std::size_t;
+
+    /*
+     *  Polymorphic memory resources for limb storage, modelled after
+     *  std::pmr (which is not available in C++11).
+     *
+     *  Every BigInt allocates its limbs through a 'memory_resource'. Results
+     *  of arithmetic operators are allocated from the resource of the left
+     *  operand, such that a whole computation can be backed by an arena and
+     *  released in one shot.
+     */
+    class memory_resource
+    {
+        public:
+
+            static constexpr size_t max_align = alignof(std::max_align_t);
+
+            virtual ~memory_resource() = default;
+
+            void* allocate(size_t bytes, size_t alignment = max_align) { return do_allocate(bytes, alignment); }
+            void deallocate(void* p, size_t bytes, size_t alignment = max_align) { do_deallocate(p, bytes, alignment); }
+            bool is_equal(const memory_resource& other) const noexcept { return do_is_equal(other); }
+
+        private:
+
+            virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+            virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+            virtual bool do_is_equal(const memory_resource& other) const noexcept { return this == &other; }
+
+    };
+
+    inline bool operator== (const memory_resource& r1, const memory_resource& r2) { return &r1 == &r2 || r1.is_equal(r2); }
+    inline bool operator!= (const memory_resource& r1, const memory_resource& r2) { return !(r1 == r2); }
+
+    /*
+     *  Process-wide memory functions, in the spirit of GMP's
+     *  mp_set_memory_functions: all limb memory of the default resource and
+     *  of the scratch space of the kernels is obtained through them, as well
+     *  as the limb buffers of contexts and accumulators.
+     *
+     *  The library itself only allocates and frees: limbs live in a
+     *  std::vector, which grows by allocate, copy and free, and scratch
+     *  buffers never need their old contents. 'reallocate' is accepted for
+     *  compatibility with GMP-style function sets, but is not called.
+     *
+     *  They must be installed before any memory is allocated through the
+     *  previous functions, or all such memory must be freed first. Passing
+     *  nullptr restores the respective default based on operator new/delete.
+     */
+    using allocate_function = void* (*)(size_t bytes);
+    using reallocate_function = void* (*)(void* p, size_t old_bytes, size_t new_bytes);
+    using free_function = void (*)(void* p, size_t bytes);
+
+    void set_memory_functions(allocate_function allocate, reallocate_function reallocate, free_function free) noexcept;
+    void get_memory_functions(allocate_function* allocate, reallocate_function* reallocate, free_function* free) noexcept;
+
+    // resource using the global operator new and delete
+    memory_resource* new_delete_resource() noexcept;
+
+    // resource using the functions installed with set_memory_functions
+    memory_resource* memory_functions_resource() noexcept;
+
+    // resource used by default constructed BigInts; initially memory_functions_resource()
+    memory_resource* get_default_resource() noexcept;
+    // install a new default resource (nullptr restores memory_functions_resource()); returns the previous one
+    memory_resource* set_default_resource(memory_resource* resource) noexcept;
+
+
+    /*
+     *  allocator adaptor for standard containers
+     */
+    template<typename T>
+    class polymorphic_allocator
+    {
+        private:
+
+            memory_resource* res;
+
+        public:
+
+            using value_type = T;
+
+            polymorphic_allocator() noexcept : res(get_default_resource()) {};
+            polymorphic_allocator(memory_resource* resource) noexcept : res(resource ? resource : get_default_resource()) {};
+            template<typename U>
+            polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : res(other.resource()) {};
+
+            T* allocate(size_t n) { return static_cast<T*>(res->allocate(n * sizeof(T), alignof(T))); }
+            void deallocate(T* p, size_t n) { res->deallocate(p, n * sizeof(T), alignof(T)); }
+
+            memory_resource* resource() const noexcept { return res; }
+
+            // like std::pmr, copies of containers do not inherit the resource
+            polymorphic_allocator select_on_container_copy_construction() const { return {}; }
+
+    };
+
+    template<typename T, typename U>
+    bool operator== (const polymorphic_allocator<T>& a1, const polymorphic_allocator<U>& a2) { return *a1.resource() == *a2.resource(); }
+    template<typename T, typename U>
+    bool operator!= (const polymorphic_allocator<T>& a1, const polymorphic_allocator<U>& a2) { return !(a1 == a2); }
+
+
+    /*
+     *  Arena: hands out memory by bumping a pointer, never frees single
+     *  allocations and returns everything to the upstream resource on
+     *  release() or destruction.
+     */
+    class monotonic_buffer_resource : public memory_resource
+    {
+        private:
+
+            memory_resource* upstream;
+            void* const initial_buffer;
+            const size_t initial_size;
+            size_t next_size;
+
+            void* current; // free space in the current buffer
+            size_t space;
+
+            struct chunk
+            {
+                chunk* next;
+                size_t bytes;
+            };
+            chunk* chunks; // buffers obtained from upstream
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void*, size_t, size_t) override {};
+
+        public:
+
+            explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource());
+            monotonic_buffer_resource(size_t initial_size, memory_resource* upstream = get_default_resource());
+            // use the caller supplied 'buffer' first, then fall back to 'upstream'
+            monotonic_buffer_resource(void* buffer, size_t size, memory_resource* upstream = get_default_resource());
+
+            monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+            monotonic_buffer_resource& operator= (const monotonic_buffer_resource&) = delete;
+
+            ~monotonic_buffer_resource() { release(); }
+
+            // free all memory at once; objects allocated from this resource must not be used any more
+            void release();
+
+            memory_resource* upstream_resource() const { return upstream; }
+
+    };
+
+
+    /*
+     *  Pool: keeps one free list per power-of-two size class and recycles
+     *  deallocated blocks; not thread safe. Blocks larger than the biggest
+     *  size class are forwarded to the upstream resource.
+     */
+    class pool_resource : public memory_resource
+    {
+        private:
+
+            static constexpr size_t min_block = 16;
+            static constexpr int num_classes = 13; // block sizes 16 bytes ... 64 KiB
+            static constexpr size_t blocks_per_chunk = 16;
+
+            memory_resource* upstream;
+            void* free_lists[num_classes]; // one intrusive singly linked list per size class
+
+            struct chunk
+            {
+                chunk* next;
+                size_t bytes;
+            };
+            chunk* chunks; // memory obtained from upstream to carve blocks from
+
+            struct oversized
+            {
+                oversized* prev;
+                oversized* next;
+                size_t bytes;
+            };
+            oversized* large_blocks; // blocks forwarded to upstream, still in use
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+        public:
+
+            explicit pool_resource(memory_resource* upstream = get_default_resource());
+
+            pool_resource(const pool_resource&) = delete;
+            pool_resource& operator= (const pool_resource&) = delete;
+
+            ~pool_resource() { release(); }
+
+            // free all memory at once; objects allocated from this resource must not be used any more
+            void release();
+
+            memory_resource* upstream_resource() const { return upstream; }
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef EXREAD_MONTGOMERY_HPP
+#define EXREAD_MONTGOMERY_HPP
+
+#include "bigint.hpp"
+#include "mpn.hpp"
+
+namespace exread {
+
+    /*
+     *  Montgomery arithmetic modulo a fixed odd modulus m of n limbs.
+     *
+     *  With R = b^n (b the limb base), the Montgomery form of a is a*R mod m.
+     *  Multiplication of Montgomery forms computes a*b*R^-1 mod m without any
+     *  division, which makes repeated modular multiplication cheap.
+     */
+    class MontgomeryContext
+    {
+        private:
+
+            BigInt m; // the modulus
+            size_t n; // number of limbs of the modulus
+            mpn::limb_t m_inv; // -m^-1 mod b
+            limb_vector r2; // R^2 mod m, zero-padded to n limbs
+
+            // {rp, n} = {tp, 2n+1} * R^-1 mod m; tp is overwritten
+            void redc(mpn::limb_t* rp, mpn::limb_t* tp) const;
+
+            // 'a' mod m as n limbs
+            void to_limbs(mpn::limb_t* rp, const BigInt& a) const;
+            BigInt from_limbs(const mpn::limb_t* ap) const;
+
+        public:
+
+            // throws std::invalid_argument unless 'modulus' is odd and positive
+            explicit MontgomeryContext(const BigInt& modulus);
+
+            const BigInt& modulus() const { return m; }
+            // number of limbs of the modulus and of all Montgomery forms
+            size_t size() const { return n; }
+
+
+            /*
+             *  raw limb interface: all operands are n-limb Montgomery forms
+             *  less than the modulus; outputs may coincide with inputs;
+             *  'scratch' must hold scratch_size() limbs
+             */
+            size_t scratch_size() const { return 2*n + 2; }
+
+            // {rp, n} = a * b * R^-1 mod m (coarsely integrated operand scanning, CIOS)
+            void mul(mpn::limb_t* rp, const mpn::limb_t* ap, const mpn::limb_t* bp, mpn::limb_t* scratch) const;
+            // {rp, n} = a^2 * R^-1 mod m (separated operand scanning, SOS, with the squaring kernel)
+            void sqr(mpn::limb_t* rp, const mpn::limb_t* ap, mpn::limb_t* scratch) const;
+            // {rp, n} = a * R mod m for 0 <= a < m
+            void to_montgomery(mpn::limb_t* rp, const mpn::limb_t* ap, mpn::limb_t* scratch) const;
+            // {rp, n} = a * R^-1 mod m
+            void from_montgomery(mpn::limb_t* rp, const mpn::limb_t* ap, mpn::limb_t* scratch) const;
+
+
+            /*
+             *  BigInt interface: Montgomery forms are residues in [0, m); other
+             *  operands are reduced modulo m first, which costs a division
+             */
+            // Montgomery form of 'a' (any integer)
+            BigInt to_montgomery(const BigInt& a) const;
+            // the integer in [0, m) with Montgomery form 'a'
+            BigInt from_montgomery(const BigInt& a) const;
+            BigInt mul(const BigInt& a, const BigInt& b) const;
+            BigInt sqr(const BigInt& a) const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef EXREAD_MPN_HPP
+#define EXREAD_MPN_HPP
+
+#include <cassert> // assert
+#include <cstdio> // std::size_t
+#include <limits> // std::numeric_limits
+
+namespace exread {
+
+    /*
+     *  Low-level kernels on limb arrays.
+     *
+     *  A number is stored as an array of limbs, least significant limb first.
+     *  Every limb only uses the lower half of the bits of 'limb_t', such that
+     *  the product of two limbs plus a carry never overflows a 'limb_t'.
+     *
+     *  All functions operate on raw pointers and lengths and write into
+     *  buffers supplied by the caller; none of them allocates. Unless stated
+     *  otherwise, an output may coincide with an input but must not partially
+     *  overlap with it.
+     */
+    namespace mpn {
+
+        using std::size_t;
+
+        using limb_t = unsigned int;
+        static constexpr int limb_bits = std::numeric_limits<limb_t>::digits / 2;
+        static constexpr limb_t limb_base = limb_t(1) << limb_bits;
+        static constexpr limb_t limb_mask = limb_base - 1;
+        static_assert(limb_bits > 0, "mpn requires an integral type with at least 2 digits as limb_t.");
+
+        /*
+         *  bit counting on single limbs (only the lower 'limb_bits' bits count)
+         */
+        // number of leading zero bits; limb_bits for x == 0
+        inline int count_leading_zeros(limb_t x)
+        {
+            assert(x <= limb_mask);
+
+#if defined(__GNUC__)
+            if (x == 0)
+                return limb_bits;
+            return __builtin_clz(x) - (std::numeric_limits<unsigned int>::digits - limb_bits);
+#else
+            int count = limb_bits;
+            for ( ; x != 0; x >>= 1)
+                --count;
+            return count;
+#endif
+        }
+
+        // number of trailing zero bits; limb_bits for x == 0
+        inline int count_trailing_zeros(limb_t x)
+        {
+            assert(x <= limb_mask);
+
+            if (x == 0)
+                return limb_bits;
+#if defined(__GNUC__)
+            return __builtin_ctz(x);
+#else
+            int count = 0;
+            for ( ; (x & 1) == 0; x >>= 1)
+                ++count;
+            return count;
+#endif
+        }
+
+        // number of set bits
+        inline int popcount(limb_t x)
+        {
+            assert(x <= limb_mask);
+
+#if defined(__GNUC__)
+            return __builtin_popcount(x);
+#else
+            int count = 0;
+            for ( ; x != 0; x &= x - 1)
+                ++count;
+            return count;
+#endif
+        }
+
+        // size of {up, n} after stripping leading zero limbs
+        inline size_t normalized_size(const limb_t* up, size_t n)
+        {
+            while (n > 0 && up[n-1] == 0)
+                --n;
+            return n;
+        }
+
+        /*
+         *  comparison
+         */
+        // compare {up, n} with {vp, n}; returns -1, 0 or 1
+        inline int cmp(const limb_t* up, const limb_t* vp, size_t n)
+        {
+            while (n > 0)
+            {
+                --n;
+                if (up[n] != vp[n])
+                    return up[n] > vp[n] ? 1 : -1;
+            }
+            return 0;
+        }
+
+        // compare the normalized numbers {up, un} and {vp, vn}; returns -1, 0 or 1
+        inline int cmp(const limb_t* up, size_t un, const limb_t* vp, size_t vn)
+        {
+            if (un != vn)
+                return un > vn ? 1 : -1;
+            return cmp(up, vp, un);
+        }
+
+        /*
+         *  addition and subtraction
+         */
+        // {rp, n} = {up, n} + {vp, n}; returns the carry (0 or 1)
+        inline limb_t add_n(limb_t* rp, const limb_t* up, const limb_t* vp, size_t n)
+        {
+            limb_t carry = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                carry += up[idx] + vp[idx];
+                rp[idx] = carry & limb_mask; // remove high digits
+                carry >>= limb_bits; // remove low digits
+            }
+            return carry;
+        }
+
+        // {rp, n} = {up, n} + v; returns the carry (0 or 1)
+        inline limb_t add_1(limb_t* rp, const limb_t* up, size_t n, limb_t v)
+        {
+            size_t idx = 0;
+            for ( ; idx < n && v != 0; ++idx)
+            {
+                v += up[idx];
+                rp[idx] = v & limb_mask;
+                v >>= limb_bits;
+            }
+            if (rp != up)
+                for ( ; idx < n; ++idx)
+                    rp[idx] = up[idx];
+            return v;
+        }
+
+        // {rp, un} = {up, un} + {vp, vn} with un >= vn; returns the carry (0 or 1)
+        inline limb_t add(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn)
+        {
+            assert(un >= vn);
+            const limb_t carry = add_n(rp, up, vp, vn);
+            return add_1(rp + vn, up + vn, un - vn, carry);
+        }
+
+        // {rp, n} = {up, n} - {vp, n}; returns the borrow (0 or 1)
+        inline limb_t sub_n(limb_t* rp, const limb_t* up, const limb_t* vp, size_t n)
+        {
+            limb_t borrow = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                const limb_t tmp = up[idx] - vp[idx] - borrow;
+                rp[idx] = tmp & limb_mask;
+                borrow = tmp >> (std::numeric_limits<limb_t>::digits - 1); // wrapped around?
+            }
+            return borrow;
+        }
+
+        // {rp, n} = {up, n} - v; returns the borrow (0 or 1)
+        inline limb_t sub_1(limb_t* rp, const limb_t* up, size_t n, limb_t v)
+        {
+            size_t idx = 0;
+            for ( ; idx < n && v != 0; ++idx)
+            {
+                const limb_t tmp = up[idx] - v;
+                rp[idx] = tmp & limb_mask;
+                v = tmp >> (std::numeric_limits<limb_t>::digits - 1);
+            }
+            if (rp != up)
+                for ( ; idx < n; ++idx)
+                    rp[idx] = up[idx];
+            return v;
+        }
+
+        // {rp, un} = {up, un} - {vp, vn} with un >= vn; returns the borrow (0 or 1)
+        inline limb_t sub(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn)
+        {
+            assert(un >= vn);
+            const limb_t borrow = sub_n(rp, up, vp, vn);
+            return sub_1(rp + vn, up + vn, un - vn, borrow);
+        }
+
+        /*
+         *  multiplication by a single limb
+         */
+        // {rp, n} = {up, n} * v; returns the high limb of the product
+        inline limb_t mul_1(limb_t* rp, const limb_t* up, size_t n, limb_t v)
+        {
+            assert(v <= limb_mask);
+
+            limb_t carry = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                carry += up[idx] * v;
+                rp[idx] = carry & limb_mask;
+                carry >>= limb_bits;
+            }
+            return carry;
+        }
+
+        // {rp, n} += {up, n} * v; returns the high limb of the result
+        inline limb_t addmul_1(limb_t* rp, const limb_t* up, size_t n, limb_t v)
+        {
+            assert(v <= limb_mask);
+
+            limb_t carry = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                carry += rp[idx] + up[idx] * v; // at most limb_mask + limb_mask + limb_mask^2 == max(limb_t)
+                rp[idx] = carry & limb_mask;
+                carry >>= limb_bits;
+            }
+            return carry;
+        }
+
+        // {rp, n} -= {up, n} * v; returns the limb to be subtracted from the next position
+        inline limb_t submul_1(limb_t* rp, const limb_t* up, size_t n, limb_t v)
+        {
+            assert(v <= limb_mask);
+
+            limb_t borrow = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                const limb_t product = up[idx] * v + borrow;
+                const limb_t low = product & limb_mask;
+                borrow = product >> limb_bits;
+                if (rp[idx] < low)
+                {
+                    rp[idx] = rp[idx] + limb_base - low;
+                    ++borrow;
+                } else {
+                    rp[idx] -= low;
+                }
+            }
+            return borrow;
+        }
+
+        /*
+         *  shifts by 0 < cnt < limb_bits
+         */
+        // {rp, n} = {up, n} << cnt; returns the bits shifted out at the top
+        // rp may overlap up if rp >= up
+        inline limb_t lshift(limb_t* rp, const limb_t* up, size_t n, int cnt)
+        {
+            assert(n > 0);
+            assert(cnt > 0 && cnt < limb_bits);
+
+            const int back = limb_bits - cnt;
+            const limb_t out = up[n-1] >> back;
+            for (size_t idx = n-1; idx > 0; --idx)
+                rp[idx] = ((up[idx] << cnt) & limb_mask) | (up[idx-1] >> back);
+            rp[0] = (up[0] << cnt) & limb_mask;
+            return out;
+        }
+
+        // {rp, n} = {up, n} >> cnt; returns the bits shifted out at the bottom, placed at the top of the limb
+        // rp may overlap up if rp <= up
+        inline limb_t rshift(limb_t* rp, const limb_t* up, size_t n, int cnt)
+        {
+            assert(n > 0);
+            assert(cnt > 0 && cnt < limb_bits);
+
+            const int back = limb_bits - cnt;
+            const limb_t out = (up[0] << back) & limb_mask;
+            for (size_t idx = 0; idx < n-1; ++idx)
+                rp[idx] = (up[idx] >> cnt) | ((up[idx+1] << back) & limb_mask);
+            rp[n-1] = up[n-1] >> cnt;
+            return out;
+        }
+
+        /*
+         *  division by a single limb
+         */
+        // {qp, n} = {up, n} / d; returns the remainder; d must be nonzero
+        inline limb_t divrem_1(limb_t* qp, const limb_t* up, size_t n, limb_t d)
+        {
+            assert(d != 0 && d <= limb_mask);
+
+            limb_t rem = 0;
+            for (size_t idx = n; idx > 0; )
+            {
+                --idx;
+                const limb_t tmp = (rem << limb_bits) | up[idx];
+                qp[idx] = tmp / d;
+                rem = tmp % d;
+            }
+            return rem;
+        }
+
+        // {up, n} mod d; d must be nonzero
+        inline limb_t mod_1(const limb_t* up, size_t n, limb_t d)
+        {
+            assert(d != 0 && d <= limb_mask);
+
+            limb_t rem = 0;
+            for (size_t idx = n; idx > 0; )
+            {
+                --idx;
+                rem = ((rem << limb_bits) | up[idx]) % d;
+            }
+            return rem;
+        }
+
+        /*
+         *  schoolbook algorithms (src/mpn.cpp)
+         */
+        // {rp, un+vn} = {up, un} * {vp, vn}; un, vn >= 1; rp must not overlap the inputs
+        void mul_basecase(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn);
+
+        // {rp, 2n} = {up, n}^2; n >= 1; rp must not overlap the input
+        void sqr_basecase(limb_t* rp, const limb_t* up, size_t n);
+
+        /*
+         *  multiplication dispatching to Karatsuba's method (src/mpn.cpp)
+         */
+        // operands of at least this many limbs are split by Karatsuba's method
+        static constexpr size_t karatsuba_threshold = 32;
+
+        // number of scratch limbs needed by mul and sqr
+        size_t mul_scratch_size(size_t un, size_t vn);
+        size_t sqr_scratch_size(size_t n);
+
+        // {rp, un+vn} = {up, un} * {vp, vn}; un >= vn >= 1; rp must not overlap the inputs;
+        // 'scratch' must hold mul_scratch_size(un, vn) limbs
+        void mul(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn, limb_t* scratch);
+
+        // {rp, 2n} = {up, n}^2; n >= 1; rp must not overlap the input;
+        // 'scratch' must hold sqr_scratch_size(n) limbs
+        void sqr(limb_t* rp, const limb_t* up, size_t n, limb_t* scratch);
+
+        // number of scratch limbs needed by divrem
+        inline size_t divrem_scratch_size(size_t nn, size_t dn) { return nn + 1 + dn; }
+
+        // {qp, nn-dn+1} = {np, nn} / {dp, dn} and {rp, dn} = {np, nn} % {dp, dn}
+        // requires nn >= dn >= 1 and dp[dn-1] != 0; 'scratch' must hold divrem_scratch_size(nn, dn) limbs;
+        // qp and rp must not overlap each other or the divisor
+        void divrem(limb_t* qp, limb_t* rp, const limb_t* np, size_t nn, const limb_t* dp, size_t dn, limb_t* scratch);
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef EXREAD_NUMTHEORY_HPP
+#define EXREAD_NUMTHEORY_HPP
+
+#include "barrett.hpp"
+#include "bigint.hpp"
+#include "montgomery.hpp"
+
+namespace exread {
+
+    /*
+     *  greatest common divisor and least common multiple (src/gcd.cpp)
+     */
+    // nonnegative gcd; gcd(0, 0) == 0
+    BigInt gcd(const BigInt& n1, const BigInt& n2);
+    // nonnegative lcm; lcm(n, 0) == 0
+    BigInt lcm(const BigInt& n1, const BigInt& n2);
+
+    // g = gcd(n1, n2) == s*n1 + t*n2
+    struct GcdExtResult
+    {
+        BigInt g, s, t;
+    };
+
+    // Bezout coefficients along with the gcd; s is the one of least absolute value,
+    // |s| <= |n2| / (2g), unless n2 == 0 (then s == sign(n1) and t == 0)
+    GcdExtResult gcdext(const BigInt& n1, const BigInt& n2);
+
+    // the inverse of n modulo |modulus| in [0, |modulus|); throws std::invalid_argument
+    // for a zero modulus or if gcd(n, modulus) != 1
+    BigInt invert(const BigInt& n, const BigInt& modulus);
+
+    /*
+     *  roots (src/root.cpp)
+     */
+    // n == root^2 + rem with 0 <= rem <= 2*root
+    struct SqrtRemResult
+    {
+        BigInt root, rem;
+    };
+
+    // floor(sqrt(n)); throws std::invalid_argument for negative n
+    BigInt isqrt(const BigInt& n);
+    // floor(sqrt(n)) and the remainder; throws std::invalid_argument for negative n
+    SqrtRemResult sqrtrem(const BigInt& n);
+
+    // k-th root truncated towards zero; throws std::invalid_argument for k == 0 and
+    // for negative n with even k
+    BigInt iroot(const BigInt& n, unsigned k);
+
+    bool is_perfect_square(const BigInt& n);
+
+    /*
+     *  modular exponentiation
+     */
+    // base^exponent mod |modulus| in [0, |modulus|); a negative exponent raises the inverse
+    // of base; throws std::invalid_argument for a zero modulus or a base without inverse
+    BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus);
+
+    // as above, reusing the precomputed constants of 'ctx' across calls
+    BigInt powmod(const BigInt& base, const BigInt& exponent, const MontgomeryContext& ctx);
+    BigInt powmod(const BigInt& base, const BigInt& exponent, const BarrettContext& ctx);
+
+}
+
+#endif
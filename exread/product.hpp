@@ -0,0 +1,38 @@
+#ifndef EXREAD_PRODUCT_HPP
+#define EXREAD_PRODUCT_HPP
+
+#include <vector> // std::vector
+
+#include "bigint.hpp"
+
+namespace exread {
+
+    namespace product_detail {
+
+        // product of the 'count' BigInts pointed to by 'factors'
+        BigInt product(const BigInt* const* factors, size_t count);
+
+    }
+
+    /*
+     *  Product of the BigInts in [begin, end), 1 for an empty range.
+     *
+     *  The factors are multiplied in a binary tree split at the middle of
+     *  their total size, such that every multiplication has operands of
+     *  similar size. Large independent subtrees run in parallel on a shared
+     *  thread pool if all factors use a thread safe resource (the memory
+     *  functions or new/delete); the result uses the resource of the first
+     *  factor.
+     */
+    template<typename Iterator>
+    BigInt product(Iterator begin, Iterator end)
+    {
+        std::vector<const BigInt*> factors;
+        for ( ; begin != end; ++begin)
+            factors.push_back(&*begin);
+        return product_detail::product(factors.data(), factors.size());
+    }
+
+}
+
+#endif
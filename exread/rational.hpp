@@ -0,0 +1,108 @@
+#ifndef EXREAD_RATIONAL_HPP
+#define EXREAD_RATIONAL_HPP
+
+#include <type_traits> // std::enable_if, std::is_integral
+
+#include "bigint.hpp"
+
+namespace exread {
+
+    /*
+     *  Exact fraction num/den of BigInts with den > 0.
+     *
+     *  Results are kept in lowest terms. Addition and multiplication take
+     *  the gcds of the denominators (and of the crossed numerators and
+     *  denominators) first, as described by Henrici and in Knuth's TAOCP
+     *  4.5.1, such that the gcds and products involve smaller numbers than
+     *  reducing the plain result would.
+     *
+     *  A lazy Rational skips the reduction: its arithmetic forms the plain
+     *  cross products, and the fraction is reduced on the first call to
+     *  numerator() or denominator() only. The results of operations with a
+     *  lazy operand are lazy. Comparisons cross-multiply and never reduce.
+     */
+    class Rational
+    {
+        private:
+
+            // mutable, such that the const accessors may reduce a lazy fraction
+            mutable BigInt num;
+            mutable BigInt den;
+            mutable bool reduced; // gcd(num, den) == 1
+            bool lazy;
+
+            // private constructor from parts with den > 0; does not reduce
+            Rational(BigInt num, BigInt den, bool reduced, bool lazy);
+
+            // reduce to lowest terms unless known to be reduced
+            void reduce() const;
+
+        public:
+
+            /*
+             *  Constructors
+             */
+            Rational() : num(), den(1), reduced(true), lazy(false) {};
+
+            // from BigInt
+            Rational(const BigInt& n) : num(n), den(1, n.resource()), reduced(true), lazy(false) {};
+
+            // from builtin integral type
+            template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+            Rational(T n) : Rational(BigInt(n)) {};
+
+            // num/den in lowest terms; throws std::invalid_argument for den == 0
+            Rational(const BigInt& num, const BigInt& den);
+
+            /*
+             *  lazy reduction
+             */
+            bool is_lazy() const { return lazy; }
+            // switch lazy reduction on or off; switching off reduces the fraction
+            Rational& set_lazy(bool on = true);
+
+            /*
+             *  access; reduces a lazy fraction first
+             */
+            const BigInt& numerator() const { reduce(); return num; }
+            const BigInt& denominator() const { reduce(); return den; }
+            bool is_negative() const { return num.is_negative(); }
+            bool is_integer() const { reduce(); return den == 1; }
+
+            /*
+             *  comparison operators
+             */
+            // three-way comparison; returns -1, 0 or 1
+            int compare(const Rational& other) const;
+
+            bool operator== (const Rational& other) const { return compare(other) == 0; }
+            bool operator!= (const Rational& other) const { return compare(other) != 0; }
+            bool operator>= (const Rational& other) const { return compare(other) >= 0; }
+            bool operator<  (const Rational& other) const { return compare(other) <  0; }
+            bool operator<= (const Rational& other) const { return compare(other) <= 0; }
+            bool operator>  (const Rational& other) const { return compare(other) >  0; }
+
+            /*
+             *  arithmetic operators
+             */
+            Rational operator+() const { return *this; };
+            Rational operator-() const { return {-num, den, reduced, lazy}; };
+
+            friend Rational operator+ (const Rational& r1, const Rational& r2);
+            friend Rational operator- (const Rational& r1, const Rational& r2);
+            friend Rational operator* (const Rational& r1, const Rational& r2);
+            friend Rational operator/ (const Rational& r1, const Rational& r2); // throws std::invalid_argument for r2 == 0
+
+            Rational& operator+= (const Rational& other) { return *this = *this + other; }
+            Rational& operator-= (const Rational& other) { return *this = *this - other; }
+            Rational& operator*= (const Rational& other) { return *this = *this * other; }
+            Rational& operator/= (const Rational& other) { return *this = *this / other; }
+
+            // multiplicative inverse; throws std::invalid_argument for zero
+            Rational inverse() const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef EXREAD_REAL_HPP
+#define EXREAD_REAL_HPP
+
+#include <limits> // std::numeric_limits
+#include <memory> // std::shared_ptr
+#include <type_traits> // std::enable_if, std::is_integral
+#include <utility> // std::move
+
+#include "bigfloat.hpp"
+#include "bigint.hpp"
+#include "rational.hpp"
+
+namespace exread {
+
+    namespace real_detail {
+
+        // node of the expression graph of a Real
+        class node
+        {
+            public:
+
+                node() : cached(), cached_p(0), valid(false) {};
+                virtual ~node() = default;
+
+                // an integer a with |a - x * 2^-p| < 1 for the value x of this node
+                BigInt approximate(long p) const;
+
+                // m with 2^(m-2) < |x| < 2^m, or no_msd if |x| < 2^limit; never returns
+                // for x == 0 and limit == no_msd
+                static constexpr long no_msd = std::numeric_limits<long>::min();
+                long msd(long limit = no_msd) const;
+
+            private:
+
+                // the best approximation so far: |cached - x * 2^-cached_p| < 1
+                mutable BigInt cached;
+                mutable long cached_p;
+                mutable bool valid;
+
+                // uncached approximate(p)
+                virtual BigInt compute(long p) const = 0;
+
+        };
+
+    }
+
+    /*
+     *  Exact real number, represented by the expression it was computed
+     *  with, in the spirit of Boehm's constructive reals.
+     *
+     *  Nothing is evaluated until an approximation is requested: every node
+     *  of the expression produces a BigInt a with |a - x * 2^-p| < 1 for any
+     *  requested p, asking its operands for just enough bits. Each node
+     *  caches the best approximation computed so far. Coarser requests are
+     *  answered from the cache, and finer ones extend the cached precision
+     *  by at least half of its bits, such that a sequence of ever finer
+     *  requests costs no more than a constant times the last one.
+     *
+     *  Equality of reals is undecidable, so comparisons take a tolerance,
+     *  and the inverse (or division by) and the square root of a value that
+     *  is exactly zero, respectively negative but very close to zero, do not
+     *  terminate when approximated. Reals sharing subexpressions must not be
+     *  approximated concurrently.
+     */
+    class Real
+    {
+        private:
+
+            std::shared_ptr<const real_detail::node> root;
+
+            Real(std::shared_ptr<const real_detail::node> root) : root(std::move(root)) {};
+
+        public:
+
+            /*
+             *  Constructors
+             */
+            // zero
+            Real() : Real(BigInt()) {};
+
+            // exact values
+            Real(const BigInt& n) : Real(Rational(n)) {};
+            Real(const Rational& r);
+            Real(const BigFloat& f);
+            explicit Real(double d) : Real(BigFloat(d)) {};
+
+            // from builtin integral type
+            template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+            Real(T n) : Real(BigInt(n)) {};
+
+            /*
+             *  approximation
+             */
+            // an integer a with |a - x * 2^-p| < 1, i.e. x to p fractional bits for p < 0
+            BigInt approximate(long p) const { return root->approximate(p); }
+
+            // approximate(p) * 2^p, which is within 2^p of x
+            BigFloat to_bigfloat(long p) const;
+
+            /*
+             *  comparison
+             */
+            // sign of x - other if |x - other| >= 2^p; may return 0 (but never a wrong sign)
+            // if |x - other| < 2^p
+            int compare(const Real& other, long p) const;
+
+            /*
+             *  arithmetic
+             */
+            Real operator+() const { return *this; };
+            Real operator-() const;
+
+            friend Real operator+ (const Real& x, const Real& y);
+            friend Real operator- (const Real& x, const Real& y);
+            friend Real operator* (const Real& x, const Real& y);
+            friend Real operator/ (const Real& x, const Real& y);
+
+            Real& operator+= (const Real& other) { return *this = *this + other; }
+            Real& operator-= (const Real& other) { return *this = *this - other; }
+            Real& operator*= (const Real& other) { return *this = *this * other; }
+            Real& operator/= (const Real& other) { return *this = *this / other; }
+
+            // x * 2^count and x * 2^-count
+            friend Real operator<< (const Real& x, long count);
+            friend Real operator>> (const Real& x, long count);
+
+            Real inverse() const;
+
+            // approximating throws std::invalid_argument once x is found to be negative
+            friend Real sqrt(const Real& x);
+
+    };
+
+    Real sqrt(const Real& x);
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include "../exread/accumulator.hpp"
+
+#include <algorithm> // std::copy, std::max
+#include <functional> // std::hash
+#include <thread> // std::thread
+
+namespace exread {
+
+    /*
+     *  BigIntAccumulator
+     */
+    void BigIntAccumulator::add_limbs(sum_vector& sums, const mpn::limb_t* limbs, size_t n)
+    {
+        if (sums.size() < n)
+            sums.resize(n, 0);
+        for (size_t idx = 0; idx < n; ++idx)
+            sums[idx] += limbs[idx];
+    }
+
+    void BigIntAccumulator::add_sums(sum_vector& sums, const sum_vector& other)
+    {
+        if (sums.size() < other.size())
+            sums.resize(other.size(), 0);
+        for (size_t idx = 0; idx < other.size(); ++idx)
+            sums[idx] += other[idx];
+    }
+
+    void BigIntAccumulator::resolve(sum_vector& sums)
+    {
+        ulonglong carry = 0;
+        for (ulonglong& sum : sums)
+        {
+            const ulonglong tmp = sum + carry;
+            sum = tmp & mpn::limb_mask;
+            carry = tmp >> mpn::limb_bits;
+        }
+        for ( ; carry != 0; carry >>= mpn::limb_bits)
+            sums.push_back(carry & mpn::limb_mask);
+    }
+
+    // make room for 'additions' more additions of full limbs
+    void BigIntAccumulator::resolve_if_full(ulonglong additions)
+    {
+        if (pending + additions > max_pending)
+        {
+            resolve(positive);
+            resolve(negative);
+            pending = 0;
+        }
+        pending += additions;
+    }
+
+    BigIntAccumulator& BigIntAccumulator::operator+= (const BigInt& n)
+    {
+        resolve_if_full(1);
+        add_limbs(n.is_negative() ? negative : positive, n.limbs_read(), n.size());
+        return *this;
+    }
+
+    BigIntAccumulator& BigIntAccumulator::operator-= (const BigInt& n)
+    {
+        resolve_if_full(1);
+        add_limbs(n.is_negative() ? positive : negative, n.limbs_read(), n.size());
+        return *this;
+    }
+
+    BigIntAccumulator& BigIntAccumulator::operator+= (const BigIntAccumulator& other)
+    {
+        // the partial sums of 'other' amount to at most other.pending + 1 additions
+        resolve_if_full(other.pending + 1);
+        add_sums(positive, other.positive);
+        add_sums(negative, other.negative);
+        return *this;
+    }
+
+    BigInt BigIntAccumulator::from_sums(sum_vector sums, memory_resource* resource)
+    {
+        resolve(sums);
+        BigInt res(resource);
+        std::copy(sums.begin(), sums.end(), res.limbs_write(sums.size()));
+        res.limbs_finish(sums.size());
+        return res;
+    }
+
+    BigInt BigIntAccumulator::value(memory_resource* resource) const
+    {
+        return from_sums(positive, resource) - from_sums(negative, resource);
+    }
+
+    void BigIntAccumulator::clear()
+    {
+        positive.clear();
+        negative.clear();
+        pending = 0;
+    }
+
+    /*
+     *  ShardedBigIntAccumulator
+     */
+    ShardedBigIntAccumulator::ShardedBigIntAccumulator(size_t count)
+        : shard_count(count != 0 ? count : std::max(std::thread::hardware_concurrency(), 1u)),
+          shards(new shard[shard_count])
+    {}
+
+    ShardedBigIntAccumulator::shard& ShardedBigIntAccumulator::this_thread_shard()
+    {
+        return shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % shard_count];
+    }
+
+    ShardedBigIntAccumulator& ShardedBigIntAccumulator::operator+= (const BigInt& n)
+    {
+        shard& s = this_thread_shard();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.sum += n;
+        return *this;
+    }
+
+    ShardedBigIntAccumulator& ShardedBigIntAccumulator::operator-= (const BigInt& n)
+    {
+        shard& s = this_thread_shard();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.sum -= n;
+        return *this;
+    }
+
+    BigInt ShardedBigIntAccumulator::value(memory_resource* resource) const
+    {
+        BigIntAccumulator total;
+        for (size_t idx = 0; idx < shard_count; ++idx)
+        {
+            std::lock_guard<std::mutex> lock(shards[idx].mutex);
+            total += shards[idx].sum;
+        }
+        return total.value(resource);
+    }
+
+    void ShardedBigIntAccumulator::clear()
+    {
+        for (size_t idx = 0; idx < shard_count; ++idx)
+        {
+            std::lock_guard<std::mutex> lock(shards[idx].mutex);
+            shards[idx].sum.clear();
+        }
+    }
+
+}
@@ -0,0 +1,31 @@
+#include "../exread/barrett.hpp"
+
+namespace exread {
+
+    BarrettContext::BarrettContext(const BigInt& modulus) : m(modulus), k(modulus.size())
+    {
+        if (m.is_negative() || m.size() == 0)
+            throw std::invalid_argument("BarrettContext: modulus must be positive");
+
+        mu = (BigInt(1) << (2 * k * mpn::limb_bits)) / m;
+    }
+
+    BigInt BarrettContext::reduce(const BigInt& x) const
+    {
+        if (x.is_negative() || x.size() > 2*k)
+        {
+            BigInt res = x % m;
+            if (res.is_negative())
+                res = res + m;
+            return res;
+        }
+
+        // estimate the quotient from the top limbs; q <= x / m and x / m - q <= 2
+        const BigInt q = (((x >> ((k-1) * mpn::limb_bits)) * mu) >> ((k+1) * mpn::limb_bits));
+        BigInt res = x - q * m;
+        while (res >= m)
+            res = res - m;
+        return res;
+    }
+
+}
@@ -0,0 +1,334 @@
+#include "../exread/bigfloat.hpp"
+#include "../exread/numtheory.hpp"
+
+#include <algorithm> // std::max, std::min, std::swap
+#include <cmath> // std::frexp, std::isfinite, std::ldexp
+#include <utility> // std::move
+
+namespace exread {
+
+    // operands are truncated to this many bits beyond the target precision
+    static constexpr size_t bigfloat_guard_bits = 32;
+
+    static void check_precision(size_t prec)
+    {
+        if (prec == 0)
+            throw std::invalid_argument("BigFloat: precision must be positive");
+    }
+
+    /*
+     *  rounding
+     */
+    BigFloat BigFloat::round(bool negative, BigInt magnitude, long exponent, bool sticky, size_t prec, RoundingMode rnd)
+    {
+        assert(!magnitude.is_negative());
+        if (magnitude == 0)
+        {
+            assert(!sticky);
+            return {BigInt(magnitude.resource()), 0, prec};
+        }
+
+        // the sticky part must lie below the rounding position
+        size_t bits = magnitude.bit_length();
+        if (sticky && bits < prec + 2)
+        {
+            const size_t shift = prec + 2 - bits;
+            magnitude <<= shift;
+            exponent -= long(shift);
+            bits += shift;
+        }
+
+        if (bits > prec)
+        {
+            const size_t shift = bits - prec;
+            const bool half = magnitude.test_bit(shift - 1);
+            const bool rest = sticky || magnitude.countr_zero() < shift - 1;
+            magnitude >>= shift;
+            exponent += long(shift);
+
+            bool up = false;
+            switch (rnd)
+            {
+                case RoundingMode::nearest_even: up = half && (rest || magnitude.test_bit(0)); break;
+                case RoundingMode::toward_zero: up = false; break;
+                case RoundingMode::upward: up = !negative && (half || rest); break;
+                case RoundingMode::downward: up = negative && (half || rest); break;
+            }
+            if (up)
+                magnitude = magnitude + 1;
+        }
+
+        // odd mantissa
+        const size_t zeros = magnitude.countr_zero();
+        magnitude >>= zeros;
+        exponent += long(zeros);
+        return {negative ? -magnitude : std::move(magnitude), exponent, prec};
+    }
+
+    bool BigFloat::round_interval(BigFloat& res, bool negative, const BigInt& lo, const BigInt& hi, long exponent, size_t prec, RoundingMode rnd)
+    {
+        // rounding is monotonic, so everything in between rounds alike
+        BigFloat lo_rounded = round(negative, lo, exponent, false, prec, rnd);
+        if (lo_rounded != round(negative, hi, exponent, false, prec, rnd))
+            return false;
+        res = std::move(lo_rounded);
+        return true;
+    }
+
+    bool BigFloat::truncated(BigInt& magnitude, long& exponent, size_t bits) const
+    {
+        magnitude = mant.is_negative() ? -mant : mant;
+        exponent = exp;
+
+        const size_t length = magnitude.bit_length();
+        if (length <= bits)
+            return false;
+        const size_t shift = length - bits;
+        magnitude >>= shift;
+        exponent += long(shift);
+        return true; // the mantissa is odd, so its lowest bit was cut off
+    }
+
+    /*
+     *  constructors
+     */
+    BigFloat::BigFloat(const BigInt& n, size_t prec, RoundingMode rnd) : BigFloat()
+    {
+        check_precision(prec);
+        *this = round(n.is_negative(), n.is_negative() ? -n : n, 0, false, prec, rnd);
+    }
+
+    BigFloat::BigFloat(double d, size_t prec, RoundingMode rnd) : BigFloat()
+    {
+        check_precision(prec);
+        if (!std::isfinite(d))
+            throw std::invalid_argument("BigFloat: infinite or NaN argument");
+
+        // d == m * 2^(e - 53) with the integer m = frac * 2^53
+        int e = 0;
+        const double frac = std::frexp(d < 0 ? -d : d, &e);
+        const BigInt m = static_cast<unsigned long long>(std::ldexp(frac, 53));
+        *this = round(d < 0, m, long(e) - 53, false, prec, rnd);
+    }
+
+    BigFloat BigFloat::rounded(size_t prec, RoundingMode rnd) const
+    {
+        check_precision(prec);
+        return round(mant.is_negative(), mant.is_negative() ? -mant : mant, exp, false, prec, rnd);
+    }
+
+    /*
+     *  comparison
+     */
+    int BigFloat::compare(const BigFloat& other) const
+    {
+        const int sign = mant.is_negative() ? -1 : mant == 0 ? 0 : 1;
+        const int other_sign = other.mant.is_negative() ? -1 : other.mant == 0 ? 0 : 1;
+        if (sign != other_sign || sign == 0)
+            return sign < other_sign ? -1 : sign > other_sign ? 1 : 0;
+
+        // same sign: the position of the leading bit, then the aligned mantissas
+        const long top = exp + long(mant.bit_length());
+        const long other_top = other.exp + long(other.mant.bit_length());
+        int res = 0;
+        if (top != other_top)
+        {
+            res = top < other_top ? -1 : 1;
+        } else {
+            const long e = std::min(exp, other.exp);
+            res = (mant << size_t(exp - e)).cmp_abs(other.mant << size_t(other.exp - e));
+        }
+        return sign * res;
+    }
+
+    /*
+     *  addition and subtraction
+     */
+    BigFloat add(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd)
+    {
+        check_precision(prec);
+        if (y.is_zero())
+            return x.rounded(prec, rnd);
+        if (x.is_zero())
+            return y.rounded(prec, rnd);
+
+        // 'a' has the leading bit at the higher position
+        const BigFloat* a = &x;
+        const BigFloat* b = &y;
+        if (a->exp + long(a->mant.bit_length()) < b->exp + long(b->mant.bit_length()))
+            std::swap(a, b);
+        const long top = a->exp + long(a->mant.bit_length());
+        const long b_top = b->exp + long(b->mant.bit_length());
+
+        // if |b| < 2^(low-1) with 'low' at least two bits below the last one of the
+        // result, a + b and a + sign(b)*2^(low-2) lie strictly between the same two
+        // neighbouring multiples of 2^low, which contain no rounding boundary
+        const long low = std::min(a->exp, top - long(prec) - 2);
+        long e = 0;
+        BigInt b_mant(b->mant.resource());
+        if (b_top <= low - 1)
+        {
+            e = low - 2;
+            b_mant = b->mant.is_negative() ? -1 : 1;
+        } else {
+            e = std::min(a->exp, b->exp);
+            b_mant = b->mant << size_t(b->exp - e);
+        }
+
+        const BigInt sum = (a->mant << size_t(a->exp - e)) + b_mant;
+        return BigFloat::round(sum.is_negative(), sum.is_negative() ? -sum : sum, e, false, prec, rnd);
+    }
+
+    BigFloat sub(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd)
+    {
+        return add(x, -y, prec, rnd);
+    }
+
+    /*
+     *  multiplication
+     */
+    BigFloat mul(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd)
+    {
+        check_precision(prec);
+        const bool negative = x.is_negative() != y.is_negative();
+        if (x.is_zero() || y.is_zero())
+            return BigFloat::round(false, 0, 0, false, prec, rnd);
+
+        BigInt tx, ty;
+        long ex = 0, ey = 0;
+        const bool cut_x = x.truncated(tx, ex, prec + bigfloat_guard_bits);
+        const bool cut_y = y.truncated(ty, ey, prec + bigfloat_guard_bits);
+        const BigInt product = tx * ty;
+        if (!cut_x && !cut_y)
+            return BigFloat::round(negative, product, ex + ey, false, prec, rnd);
+
+        // with x = tx + dx and y = ty + dy, 0 <= dx, dy < 1 (in units of the truncated
+        // operands), the exact product is below tx*ty + tx + ty + 1
+        BigInt bound = product + 1;
+        if (cut_x)
+            bound = bound + ty;
+        if (cut_y)
+            bound = bound + tx;
+        BigFloat res;
+        if (BigFloat::round_interval(res, negative, product, bound, ex + ey, prec, rnd))
+            return res;
+
+        const BigInt exact = (x.mant * y.mant);
+        return BigFloat::round(negative, negative ? -exact : exact, x.exp + y.exp, false, prec, rnd);
+    }
+
+    /*
+     *  division
+     */
+    // floor(n * 2^shift / d) >= 2^(bits-1) for n, d > 0
+    static size_t quotient_shift(const BigInt& n, const BigInt& d, size_t bits)
+    {
+        const long shift = long(bits) + long(d.bit_length()) - long(n.bit_length());
+        return size_t(std::max(shift, 0l));
+    }
+
+    BigFloat div(const BigFloat& x, const BigFloat& y, size_t prec, RoundingMode rnd)
+    {
+        check_precision(prec);
+        if (y.is_zero())
+            throw std::invalid_argument("Division by BigFloat(0)");
+        const bool negative = x.is_negative() != y.is_negative();
+        if (x.is_zero())
+            return BigFloat::round(false, 0, 0, false, prec, rnd);
+
+        BigInt tx, ty;
+        long ex = 0, ey = 0;
+        const bool cut_x = x.truncated(tx, ex, prec + bigfloat_guard_bits);
+        const bool cut_y = y.truncated(ty, ey, prec + bigfloat_guard_bits);
+
+        if (cut_x || cut_y)
+        {
+            // (tx + dx) / (ty + dy) lies in [tx / (ty + 1), (tx + 1) / ty] (for cut operands)
+            const size_t shift = quotient_shift(tx, ty, prec + bigfloat_guard_bits);
+            const BigInt lo = (tx << shift) / (cut_y ? ty + 1 : ty);
+            const BigInt hi = (((cut_x ? tx + 1 : tx) << shift) + ty - 1) / ty;
+            BigFloat res;
+            if (BigFloat::round_interval(res, negative, lo, hi, ex - ey - long(shift), prec, rnd))
+                return res;
+            x.truncated(tx, ex, x.mant.bit_length());
+            y.truncated(ty, ey, y.mant.bit_length());
+        }
+
+        // the quotient has at least prec + 2 bits, the remainder makes the sticky part
+        const size_t shift = quotient_shift(tx, ty, prec + 2);
+        const BigInt n = tx << shift;
+        const BigInt q = n / ty;
+        const bool sticky = n - q * ty != 0;
+        return BigFloat::round(negative, q, ex - ey - long(shift), sticky, prec, rnd);
+    }
+
+    /*
+     *  square root
+     */
+    BigFloat sqrt(const BigFloat& x, size_t prec, RoundingMode rnd)
+    {
+        check_precision(prec);
+        if (x.is_negative())
+            throw std::invalid_argument("sqrt: negative argument");
+        if (x.is_zero())
+            return BigFloat::round(false, 0, 0, false, prec, rnd);
+
+        // m * 2^e with even e and a root of at least 'bits' bits
+        const auto prepare = [](BigInt& m, long& e, size_t bits) {
+            if (e % 2 != 0)
+            {
+                m <<= 1;
+                e -= 1;
+            }
+            const size_t length = m.bit_length();
+            if (length < 2*bits)
+            {
+                const size_t shift = (2*bits - length + 1) / 2 * 2;
+                m <<= shift;
+                e -= long(shift);
+            }
+        };
+
+        BigInt m;
+        long e = 0;
+        if (x.truncated(m, e, 2 * (prec + bigfloat_guard_bits)))
+        {
+            // the cut-off part is below one unit of m, or two after making the exponent
+            // even, so the root lies in [isqrt(m), isqrt(m) + 2]
+            prepare(m, e, prec + bigfloat_guard_bits);
+            const BigInt root = isqrt(m);
+            BigFloat res;
+            if (BigFloat::round_interval(res, false, root, root + 2, e / 2, prec, rnd))
+                return res;
+            x.truncated(m, e, x.mant.bit_length());
+        }
+
+        prepare(m, e, prec + 2);
+        const SqrtRemResult root = sqrtrem(m);
+        return BigFloat::round(false, root.root, e / 2, root.rem != 0, prec, rnd);
+    }
+
+    /*
+     *  arithmetic operators
+     */
+    BigFloat operator+ (const BigFloat& x, const BigFloat& y)
+    {
+        return add(x, y, std::max(x.prec, y.prec));
+    }
+
+    BigFloat operator- (const BigFloat& x, const BigFloat& y)
+    {
+        return sub(x, y, std::max(x.prec, y.prec));
+    }
+
+    BigFloat operator* (const BigFloat& x, const BigFloat& y)
+    {
+        return mul(x, y, std::max(x.prec, y.prec));
+    }
+
+    BigFloat operator/ (const BigFloat& x, const BigFloat& y)
+    {
+        return div(x, y, std::max(x.prec, y.prec));
+    }
+
+}
@@ -1,187 +1,123 @@
 #include "../exread/bigint.hpp"
+#include "scratch.hpp"
+
+#include <cmath> // HUGE_VAL, std::ldexp
 
 namespace exread {
 
     /*
-     *  operator==
+     *  string constructor
      */
-    bool BigInt::operator== (const BigInt& other) const
+    // number of decimal digits processed per step: the largest k with 10^k <= limb_mask
+    static constexpr int decimal_chunk_digits()
     {
-        if (neg != other.neg)
-            return false;
+        int k = 0;
+        for (mpn::limb_t power = 10; power <= mpn::limb_mask; power *= 10)
+            ++k;
+        return k;
+    }
 
-        size_t size = digits.size();
+    BigInt::BigInt(const std::string& n, memory_resource* resource) : neg(false), digits(limb_vector::allocator_type(resource))
+    {
+        constexpr int chunk_digits = decimal_chunk_digits();
 
-        if (size != other.digits.size())
-            return false;
+        const bool negative = n.size() > 0 && n[0] == '-';
+        size_t pos = negative ? 1 : 0;
+        digits.reserve((n.size() - pos) / chunk_digits + 1);
+
+        // digits = digits * 10^k + <next k decimal digits>
+        while (pos < n.size())
+        {
+            const size_t chunk_end = std::min(pos + chunk_digits, n.size());
+            base_int chunk = 0, scale = 1;
+            for ( ; pos < chunk_end; ++pos)
+            {
+                const char tmp = n[pos] - '0';
+                if (tmp < 0 || tmp > 9)
+                    throw std::invalid_argument("BigInt(\"" + n + "\")");
+                chunk = chunk * 10 + tmp;
+                scale *= 10;
+            }
 
-        for (size_t idx = 0; idx < size; ++size)
-            if (digits[idx] != other.digits[idx])
-                return false;
+            base_int carry = mpn::mul_1(digits.data(), digits.data(), digits.size(), scale);
+            carry += mpn::add_1(digits.data(), digits.data(), digits.size(), chunk);
+            if (carry)
+                digits.push_back(carry);
+        }
 
-        return true;
+        neg = negative && !digits.empty();
     }
 
     /*
-     *  operator>=
+     *  compare
      */
-    bool BigInt::operator>= (const BigInt& other) const
+    int BigInt::compare(const BigInt& other) const
     {
-        if ( neg && (!other.neg) )
-            return false;
-
-        else if ( (!neg) && other.neg )
-            return true;
-
-        else if ( (!neg) && (!other.neg) ) {
-            size_t size = digits.size();
-
-            if (size > other.digits.size())
-                return true;
-            else if (size < other.digits.size())
-                return false;
-
-            assert((size == other.digits.size()));
-
-            if (size == 0)
-                return true;
-
-            for (size_t idx = size-1; ; --idx)
-            {
-                if (digits[idx] > other.digits[idx])
-                    return true;
-                else if (digits[idx] < other.digits[idx])
-                    return false;
-
-                if (idx == 0)
-                    break;
-            }
-
-            assert(*this == other);
+        if (neg != other.neg)
+            return neg ? -1 : 1;
 
-            return true;
-        } else {
-            return -other >= -*this;
-        }
+        // same sign: compare absolute values, reversed for negative numbers
+        const int res = cmp_abs(other);
+        return neg ? -res : res;
+    }
 
+    /*
+     *  cmp_abs
+     */
+    int BigInt::cmp_abs(const BigInt& other) const
+    {
+        return mpn::cmp(digits.data(), digits.size(), other.digits.data(), other.digits.size());
     }
 
     /*
      *  binary arithmetic operators
      */
     // helper function add
-    template<int half_base_digits, typename base_int, base_int leading_mask>
-    static std::vector<base_int> add(const std::vector<base_int>& n1, const std::vector<base_int>& n2)
+    static limb_vector add(const limb_vector& n1, const limb_vector& n2, memory_resource* resource)
     {
         assert(n1.size() >= n2.size());
 
-        base_int overflow = 0;
-        size_t idx;
-        std::vector<base_int> result = n1;
-        for (idx = 0; idx < n2.size(); ++idx)
-        {
-            overflow = result[idx] + n2[idx] + overflow;
-            result[idx] = overflow & leading_mask; // remove high digits
-            overflow >>= half_base_digits; // remove low digits
-        }
+        limb_vector result(n1.size() + 1, 0, resource);
+        result.back() = mpn::add(result.data(), n1.data(), n1.size(), n2.data(), n2.size());
 
-        // further overflow after n2 depleted?
-        if (overflow)
-        {
-            if (n1.size() == n2.size())
-                result.push_back(overflow);
-            else
-            {
-                for ( ; idx < n1.size(); ++idx)
-                {
-                    overflow += result[idx];
-                    result[idx] = overflow & leading_mask; // remove high digits
-                    overflow >>= half_base_digits; // remove low digits
-                    if (overflow == 0)
-                        break;
-                }
-                // last overflow
-                if (overflow)
-                    result.push_back(overflow);
-            }
-        }
+        // remove leading zero
+        if (result.back() == 0)
+            result.pop_back();
 
         return result;
     }
     // helper function subtract
-    template<int half_base_digits, typename base_int, base_int leading_mask>
-    static std::vector<base_int> subtract(const std::vector<base_int>& n1, const std::vector<base_int>& n2)
+    static limb_vector subtract(const limb_vector& n1, const limb_vector& n2, memory_resource* resource)
     {
         assert(n1.size() >= n2.size());
 
-        base_int overflow = 0;
-        const base_int overflow_guard = 1 << half_base_digits;
-        size_t idx;
-        std::vector<base_int> result = n1;
-        for (idx = 0; idx < n2.size(); ++idx)
-        {
-            overflow = result[idx] - (n2[idx] + overflow);
-            if (overflow > overflow_guard) // overflow occurred
-            {
-                result[idx] = overflow + overflow_guard;
-                overflow = 1;
-            } else {
-                result[idx] = overflow;
-                overflow = 0;
-            }
-        }
-
-        // further overflow after n2 depleted?
-        if (n1.size() == n2.size())
-            assert(overflow == 0); // function assumes n1 >= n2
-
-        if (overflow)
-        {
-            for ( ; idx < n1.size(); ++idx)
-            {
-                overflow = result[idx] - overflow;
-                if (overflow > overflow_guard) // overflow occurred
-                {
-                    result[idx] = overflow + overflow_guard;
-                    overflow = 1;
-                } else {
-                    result[idx] = overflow;
-                    overflow = 0;
-                    break;
-                }
-            }
-            // last overflow
-            assert(overflow == 0); // function assumes n1 >= n2
-        }
+        limb_vector result(n1.size(), 0, resource);
+        const mpn::limb_t borrow = mpn::sub(result.data(), n1.data(), n1.size(), n2.data(), n2.size());
+        assert(borrow == 0); // function assumes n1 >= n2
+        (void) borrow;
 
         // remove leading zeros
-        while (result.size() > 0 && result.back() == 0)
-            result.pop_back();
+        result.resize(mpn::normalized_size(result.data(), result.size()));
 
         return result;
     }
 
     BigInt operator+ (const BigInt& n1, const BigInt& n2)
     {
+        memory_resource* const resource = n1.resource();
+
         if (n1.neg == n2.neg)
         {
             if (n1.digits.size() >= n2.digits.size())
-                return {n1.neg, add<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(n1.digits, n2.digits)};
+                return {n1.neg, add(n1.digits, n2.digits, resource)};
             else
-                return {n1.neg, add<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(n2.digits, n1.digits)};
+                return {n1.neg, add(n2.digits, n1.digits, resource)};
         } else {
-            if (n1.neg)
-            {
-                if (-n1 >= n2)
-                    return {true, subtract<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(n1.digits, n2.digits)};
-                else
-                    return {false, subtract<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(n2.digits, n1.digits)};
-            } else {
-                if (n1 >= -n2)
-                    return {false, subtract<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(n1.digits, n2.digits)};
-                else
-                    return {true, subtract<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(n2.digits, n1.digits)};
-            }
+            // the sign of the result is that of the operand with the larger absolute value
+            if (n1.cmp_abs(n2) >= 0)
+                return {n1.neg, subtract(n1.digits, n2.digits, resource)};
+            else
+                return {n2.neg, subtract(n2.digits, n1.digits, resource)};
         };
     }
     BigInt operator- (const BigInt& n1, const BigInt& n2)
@@ -191,95 +127,630 @@ namespace exread {
 
     BigInt operator* (const BigInt& n1, const BigInt& n2)
     {
-        using base_int = BigInt::base_int;
-        std::vector<base_int> res_digits;
+        if (n1.digits.empty() || n2.digits.empty())
+            return BigInt(n1.resource());
 
-        for (size_t idx1 = 0; idx1 < n1.digits.size(); ++idx1)
-            for (size_t idx2 = 0; idx2 < n2.digits.size(); ++idx2)
-            {
-                base_int tmp = n1.digits[idx1] * n2.digits[idx2];
-                std::vector<base_int> tmp_digits(idx1+idx2+2);
-
-                *(tmp_digits.end()-2) = tmp&BigInt::leading_mask;
-                tmp >>= BigInt::half_base_digits;
-                if (tmp == 0)
-                    tmp_digits.pop_back();
-                else
-                    tmp_digits.back() = tmp;
-
-                if (res_digits.size() >= tmp_digits.size())
-                    res_digits = add<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(res_digits, tmp_digits);
-                else
-                    res_digits = add<BigInt::half_base_digits,BigInt::base_int,BigInt::leading_mask>(tmp_digits, res_digits);
-            }
+        limb_vector res_digits(n1.digits.size() + n2.digits.size(), 0, n1.resource());
+        if (&n1 == &n2)
+        {
+            const scratch_buffer scratch(mpn::sqr_scratch_size(n1.digits.size()));
+            mpn::sqr(res_digits.data(), n1.digits.data(), n1.digits.size(), scratch.data());
+        } else {
+            const BigInt& u = n1.digits.size() >= n2.digits.size() ? n1 : n2;
+            const BigInt& v = n1.digits.size() >= n2.digits.size() ? n2 : n1;
+            const scratch_buffer scratch(mpn::mul_scratch_size(u.digits.size(), v.digits.size()));
+            mpn::mul(res_digits.data(), u.digits.data(), u.digits.size(), v.digits.data(), v.digits.size(), scratch.data());
+        }
 
-        return {n1.neg^n2.neg, std::move(res_digits)};
+        // remove leading zero
+        if (res_digits.back() == 0)
+            res_digits.pop_back();
+
+        return {n1.neg != n2.neg, std::move(res_digits)};
     }
 
     BigInt operator/ (const BigInt& n1, const BigInt& n2)
     {
+        // handle division by zero
+        if (n2.digits.size() == 0)
+            throw std::invalid_argument("Division by BigInt(0)");
+
+        // handle zero result
+        if (n1.cmp_abs(n2) < 0)
+            return BigInt(n1.resource());
+
+        assert(n1.digits.size() >= n2.digits.size());
+        assert(n1.digits.size() >= 1);
+
+        const size_t nn = n1.digits.size();
+        const size_t dn = n2.digits.size();
+        limb_vector res_digits(nn - dn + 1, 0, n1.resource());
+
+        // division by a single digit
+        if (dn == 1)
+            mpn::divrem_1(res_digits.data(), n1.digits.data(), nn, n2.digits[0]);
+
+        // division with multiple digits
+        else {
+            const scratch_buffer remainder(dn);
+            const scratch_buffer scratch(mpn::divrem_scratch_size(nn, dn));
+            mpn::divrem(res_digits.data(), remainder.data(), n1.digits.data(), nn, n2.digits.data(), dn, scratch.data());
+        }
+
+        // remove leading zeros
+        res_digits.resize(mpn::normalized_size(res_digits.data(), res_digits.size()));
+
+        // the quotient is truncated towards zero
+        return {n1.neg != n2.neg, std::move(res_digits)};
+    }
 
-        using base_int = BigInt::base_int;
 
+    BigInt operator% (const BigInt& n1, const BigInt& n2)
+    {
         // handle division by zero
         if (n2.digits.size() == 0)
             throw std::invalid_argument("Division by BigInt(0)");
 
-        // handle sign
-        if (n1.neg)
+        // handle zero quotient
+        if (n1.cmp_abs(n2) < 0)
+            return {n1, n1.resource()};
+
+        const size_t nn = n1.digits.size();
+        const size_t dn = n2.digits.size();
+        limb_vector res_digits(dn, 0, n1.resource());
+
+        // division by a single digit
+        if (dn == 1)
         {
-            if (n2.neg)
-                return (-n1) / (-n2);
-            else
-                return -( (-n1)/n2 );
-        } else if (n2.neg) {
-            return -( n1/(-n2) );
+            const scratch_buffer quotient(nn);
+            res_digits[0] = mpn::divrem_1(quotient.data(), n1.digits.data(), nn, n2.digits[0]);
         }
 
-        // handle zero result
-        if (  (n2 > n1) || (n1.digits.size() == 0)  )
+        // division with multiple digits
+        else {
+            const scratch_buffer quotient(nn - dn + 1);
+            const scratch_buffer scratch(mpn::divrem_scratch_size(nn, dn));
+            mpn::divrem(quotient.data(), res_digits.data(), n1.digits.data(), nn, n2.digits.data(), dn, scratch.data());
+        }
+
+        // remove leading zeros
+        res_digits.resize(mpn::normalized_size(res_digits.data(), res_digits.size()));
+
+        // the remainder has the sign of the dividend
+        return {n1.neg, std::move(res_digits)};
+    }
+
+    /*
+     *  shift operators
+     */
+    BigInt& BigInt::operator<<= (size_t count)
+    {
+        if (digits.empty())
+            return *this;
+
+        const size_t size = digits.size();
+        const size_t limbs = count / half_base_digits;
+        const int bits = count % half_base_digits;
+
+        digits.resize(size + limbs + 1);
+        base_int* const d = digits.data();
+        if (bits)
+            d[size + limbs] = mpn::lshift(d + limbs, d, size, bits);
+        else
+            std::copy_backward(d, d + size, d + size + limbs);
+        std::fill(d, d + limbs, 0);
+
+        // remove leading zero
+        if (digits.back() == 0)
+            digits.pop_back();
+
+        return *this;
+    }
+
+    BigInt& BigInt::operator>>= (size_t count)
+    {
+        const size_t limbs = count / half_base_digits;
+        const int bits = count % half_base_digits;
+
+        if (limbs >= digits.size())
+        {
+            // only the sign remains: 0 or -1
+            digits.resize(neg ? 1 : 0);
+            if (neg)
+                digits[0] = 1;
+            return *this;
+        }
+
+        // negative numbers: floor(-m / 2^count) == -ceil(m / 2^count)
+        base_int* const d = digits.data();
+        bool inexact = false;
+        for (size_t idx = 0; idx < limbs && !inexact; ++idx)
+            inexact = d[idx] != 0;
+
+        const size_t size = digits.size() - limbs;
+        if (bits)
+            inexact |= mpn::rshift(d, d + limbs, size, bits) != 0;
+        else
+            std::copy(d + limbs, d + limbs + size, d);
+        digits.resize(mpn::normalized_size(d, size));
+
+        if (neg && inexact)
+        {
+            digits.push_back(0);
+            mpn::add_1(digits.data(), digits.data(), digits.size(), 1);
+            if (digits.back() == 0)
+                digits.pop_back();
+        }
+        if (digits.empty())
+            neg = false;
+
+        return *this;
+    }
+
+    BigInt operator<< (const BigInt& n, size_t count)
+    {
+        if (n.digits.empty())
+            return BigInt(n.resource());
+
+        const size_t size = n.digits.size();
+        const size_t limbs = count / BigInt::half_base_digits;
+        const int bits = count % BigInt::half_base_digits;
+
+        limb_vector res_digits(size + limbs + 1, 0, n.resource());
+        if (bits)
+            res_digits.back() = mpn::lshift(res_digits.data() + limbs, n.digits.data(), size, bits);
+        else
+            std::copy(n.digits.begin(), n.digits.end(), res_digits.begin() + limbs);
+
+        // remove leading zero
+        if (res_digits.back() == 0)
+            res_digits.pop_back();
+
+        return {n.neg, std::move(res_digits)};
+    }
+
+    BigInt operator>> (const BigInt& n, size_t count)
+    {
+        BigInt res(n, n.resource());
+        res >>= count;
+        return res;
+    }
+
+    /*
+     *  bit queries
+     */
+    size_t BigInt::bit_length() const
+    {
+        if (digits.empty())
             return 0;
+        return digits.size() * half_base_digits - mpn::count_leading_zeros(digits.back());
+    }
 
-        assert(n1.digits.size() >= n2.digits.size());
-        assert(n1.digits.size() >= 1);
+    size_t BigInt::popcount() const
+    {
+        size_t count = 0;
+        for (base_int digit : digits)
+            count += mpn::popcount(digit);
+        return count;
+    }
+
+    size_t BigInt::countr_zero() const
+    {
+        for (size_t idx = 0; idx < digits.size(); ++idx)
+            if (digits[idx] != 0)
+                return idx * half_base_digits + mpn::count_trailing_zeros(digits[idx]);
+        return 0;
+    }
+
+    // bit 'idx' of the magnitude {digits, size}
+    static bool magnitude_bit(const mpn::limb_t* digits, size_t size, size_t idx)
+    {
+        const size_t limb = idx / mpn::limb_bits;
+        return limb < size && ((digits[limb] >> (idx % mpn::limb_bits)) & 1);
+    }
+
+    bool BigInt::test_bit(size_t idx) const
+    {
+        const bool bit = magnitude_bit(digits.data(), digits.size(), idx);
+        if (!neg)
+            return bit;
+
+        // -m == ~(m - 1): below the lowest set bit t of m, m - 1 has ones; at t a zero; above t the bits of m
+        const size_t lowest = countr_zero();
+        if (idx < lowest)
+            return false;
+        if (idx == lowest)
+            return true;
+        return !bit;
+    }
+
+    // set bit 'idx' of the magnitude to 'value' and strip leading zeros
+    static void set_magnitude_bit(limb_vector& digits, size_t idx, bool value)
+    {
+        const size_t limb = idx / mpn::limb_bits;
+        const mpn::limb_t mask = mpn::limb_t(1) << (idx % mpn::limb_bits);
+        if (value)
+        {
+            if (limb >= digits.size())
+                digits.resize(limb + 1);
+            digits[limb] |= mask;
+        } else if (limb < digits.size()) {
+            digits[limb] &= ~mask;
+            digits.resize(mpn::normalized_size(digits.data(), digits.size()));
+        }
+    }
 
-        // division as with base_int
-        if (n1.digits.size() == 1)
+    BigInt& BigInt::set_bit(size_t idx)
+    {
+        if (!neg)
         {
-            assert(n2.digits.size() == 1);
-            return n1.digits[0] / n2.digits[0];
+            set_magnitude_bit(digits, idx, true);
+            return *this;
+        }
 
+        // setting a bit of ~(m - 1) clears it in m - 1; the result stays negative
+        mpn::sub_1(digits.data(), digits.data(), digits.size(), 1);
+        set_magnitude_bit(digits, idx, false);
+        digits.push_back(0);
+        mpn::add_1(digits.data(), digits.data(), digits.size(), 1);
+        digits.resize(mpn::normalized_size(digits.data(), digits.size()));
+        return *this;
+    }
 
-        // division with multiple digits
+    BigInt& BigInt::clear_bit(size_t idx)
+    {
+        if (!neg)
+        {
+            set_magnitude_bit(digits, idx, false);
+            return *this;
+        }
+
+        // clearing a bit of ~(m - 1) sets it in m - 1; the result stays negative
+        mpn::sub_1(digits.data(), digits.data(), digits.size(), 1);
+        set_magnitude_bit(digits, idx, true);
+        digits.push_back(0);
+        mpn::add_1(digits.data(), digits.data(), digits.size(), 1);
+        digits.resize(mpn::normalized_size(digits.data(), digits.size()));
+        return *this;
+    }
+
+    /*
+     *  conversion
+     */
+    double BigInt::to_double() const
+    {
+        using ulonglong = unsigned long long;
+        constexpr size_t window = std::numeric_limits<ulonglong>::digits;
+        constexpr size_t mantissa_bits = std::numeric_limits<double>::digits;
+
+        const size_t bits = bit_length();
+        if (bits == 0)
+            return 0.;
+        if (bits > size_t(std::numeric_limits<double>::max_exponent)) // |n| >= 2^1024
+            return neg ? -HUGE_VAL : HUGE_VAL;
+
+        // the top bits (at most 'window' of them) and whether any bit below them is set
+        const size_t shift = bits > window ? bits - window : 0;
+        ulonglong top = 0;
+        for (size_t idx = shift / mpn::limb_bits; idx < digits.size(); ++idx)
+        {
+            const long pos = long(idx * mpn::limb_bits) - long(shift);
+            top |= pos >= 0 ? ulonglong(digits[idx]) << pos : ulonglong(digits[idx]) >> -pos;
+        }
+        bool sticky = countr_zero() < shift;
+
+        // round to the mantissa bits, ties to even
+        size_t exponent = shift;
+        if (bits - shift > mantissa_bits)
+        {
+            const size_t drop = bits - shift - mantissa_bits;
+            const bool half = (top >> (drop - 1)) & 1;
+            sticky = sticky || (top & ((ulonglong(1) << (drop - 1)) - 1)) != 0;
+            top >>= drop;
+            exponent += drop;
+            if (half && (sticky || (top & 1)))
+                ++top;
+        }
+
+        // exact, or infinity if the rounding carried into 2^1024
+        const double magnitude = std::ldexp(double(top), int(exponent));
+        return neg ? -magnitude : magnitude;
+    }
+
+    /*
+     *  bitwise operators
+     */
+    // two's complement of the number with magnitude {up, un} and sign 'neg' in {rp, n}; n > un;
+    // up may equal rp for an in-place conversion
+    static void to_twos_complement(mpn::limb_t* rp, size_t n, const mpn::limb_t* up, size_t un, bool neg)
+    {
+        assert(n > un);
+
+        // std::copy requires the destination to start outside the source
+        if (rp != up)
+            std::copy(up, up + un, rp);
+        std::fill(rp + un, rp + n, 0);
+        if (neg)
+        {
+            // -m == ~(m - 1)
+            mpn::sub_1(rp, rp, n, 1);
+            for (size_t idx = 0; idx < n; ++idx)
+                rp[idx] = ~rp[idx] & mpn::limb_mask;
+        }
+    }
+
+    // convert the two's complement number {rp, n} to its magnitude in place; returns the sign
+    static bool from_twos_complement(mpn::limb_t* rp, size_t n)
+    {
+        const bool neg = rp[n-1] >> (mpn::limb_bits - 1);
+        if (neg)
+        {
+            // m == ~r + 1
+            for (size_t idx = 0; idx < n; ++idx)
+                rp[idx] = ~rp[idx] & mpn::limb_mask;
+            mpn::add_1(rp, rp, n, 1);
+        }
+        return neg;
+    }
+
+    template<typename Op>
+    BigInt& BigInt::bitwise_assign(const BigInt& other, Op op)
+    {
+        // one extra limb for the sign
+        const size_t size = std::max(digits.size(), other.digits.size()) + 1;
+        const scratch_buffer other_twos(size);
+        to_twos_complement(other_twos.data(), size, other.digits.data(), other.digits.size(), other.neg);
+
+        const size_t old_size = digits.size();
+        digits.resize(size);
+        base_int* const d = digits.data();
+        to_twos_complement(d, size, d, old_size, neg);
+
+        for (size_t idx = 0; idx < size; ++idx)
+            d[idx] = op(d[idx], other_twos.data()[idx]);
+
+        neg = from_twos_complement(d, size);
+        digits.resize(mpn::normalized_size(d, size));
+        if (digits.empty())
+            neg = false;
+
+        return *this;
+    }
+
+    BigInt BigInt::operator~() const
+    {
+        // ~n == -n - 1 == -(n + 1)
+        BigInt res(*this, resource());
+        res.digits.push_back(0);
+        base_int* const d = res.digits.data();
+        if (neg)
+            mpn::sub_1(d, d, res.digits.size(), 1);
+        else
+            mpn::add_1(d, d, res.digits.size(), 1);
+        res.digits.resize(mpn::normalized_size(d, res.digits.size()));
+        res.neg = !neg && !res.digits.empty();
+        return res;
+    }
+
+    BigInt& BigInt::operator&= (const BigInt& other)
+    {
+        // nonnegative operands: no conversion needed
+        if (!neg && !other.neg)
+        {
+            digits.resize(std::min(digits.size(), other.digits.size()));
+            for (size_t idx = 0; idx < digits.size(); ++idx)
+                digits[idx] &= other.digits[idx];
+            digits.resize(mpn::normalized_size(digits.data(), digits.size()));
+            return *this;
+        }
+        return bitwise_assign(other, [](base_int a, base_int b) { return a & b; });
+    }
+
+    BigInt& BigInt::operator|= (const BigInt& other)
+    {
+        return bitwise_assign(other, [](base_int a, base_int b) { return a | b; });
+    }
+
+    BigInt& BigInt::operator^= (const BigInt& other)
+    {
+        return bitwise_assign(other, [](base_int a, base_int b) { return a ^ b; });
+    }
+
+    BigInt operator& (const BigInt& n1, const BigInt& n2)
+    {
+        BigInt res(n1, n1.resource());
+        res &= n2;
+        return res;
+    }
+
+    BigInt operator| (const BigInt& n1, const BigInt& n2)
+    {
+        BigInt res(n1, n1.resource());
+        res |= n2;
+        return res;
+    }
+
+    BigInt operator^ (const BigInt& n1, const BigInt& n2)
+    {
+        BigInt res(n1, n1.resource());
+        res ^= n2;
+        return res;
+    }
+
+    /*
+     *  power
+     *
+     *  Left-to-right binary exponentiation of the odd part of the base on raw
+     *  limbs, ping-ponging between two buffers sized up front for the result;
+     *  the power of two is applied as a single shift at the end.
+     */
+    BigInt pow(const BigInt& base, unsigned exponent)
+    {
+        if (exponent == 0)
+            return BigInt(1, base.resource());
+        if (base == 0)
+            return BigInt(base.resource());
+
+        const bool negative = base.is_negative() && (exponent & 1);
+        const size_t zeros = base.countr_zero();
+        const BigInt odd = (base.is_negative() ? -base : base) >> zeros;
+
+        BigInt res(base.resource());
+        if (odd == 1)
+        {
+            res.limbs_write(1)[0] = 1;
+            res.limbs_finish(1, negative);
         } else {
+            // |odd^exponent| < 2^(bits*exponent); squaring and multiplying may write up to
+            // two limbs beyond the normalized result
+            const size_t bn = odd.size();
+            const size_t capacity = (odd.bit_length() * exponent + mpn::limb_bits - 1) / mpn::limb_bits + 2;
+            const scratch_buffer tmp(capacity);
+            const scratch_buffer scratch(mpn::sqr_scratch_size(capacity));
+            mpn::limb_t* acc = res.limbs_write(capacity);
+            mpn::limb_t* other = tmp.data();
+
+            std::copy(odd.limbs_read(), odd.limbs_read() + bn, acc);
+            size_t n = bn;
+            unsigned mask = 1;
+            while (mask <= exponent / 2)
+                mask <<= 1;
+            for (mask >>= 1; mask != 0; mask >>= 1)
+            {
+                mpn::sqr(other, acc, n, scratch.data());
+                n = mpn::normalized_size(other, 2*n);
+                std::swap(acc, other);
+                if (exponent & mask)
+                {
+                    const scratch_buffer mul_scratch(mpn::mul_scratch_size(n, bn));
+                    mpn::mul(other, acc, n, odd.limbs_read(), bn, mul_scratch.data());
+                    n = mpn::normalized_size(other, n + bn);
+                    std::swap(acc, other);
+                }
+            }
+            if (acc != res.limbs_read())
+                std::copy(acc, acc + n, res.limbs_write(capacity));
+            res.limbs_finish(n, negative);
+        }
 
-            assert(n1.digits.size() >= 2);
+        res <<= exponent * zeros;
+        return res;
+    }
 
-            // compute a lower bound as "<hightes two digits of n1> / (<hightes digit of n2> + 1)"
-            const base_int tmp_num = (n1.digits.back() << BigInt::half_base_digits) | *(n1.digits.end()-2);
-            const base_int tmp_den = n2.digits.back() + 1;
-            const base_int tmp_res = (tmp_num / tmp_den);
+    /*
+     *  addmul, submul
+     */
+    // factors of at most this many limbs are multiplied into the accumulator row by row
+    // with addmul_1 / submul_1, longer ones form the product in scratch space first
+    static constexpr size_t addmul_row_limbs = std::numeric_limits<unsigned long long>::digits / mpn::limb_bits;
 
-            // correct shift introduced by only considering the leading digits in "tmp_res"
-            const size_t number_of_leading_zeros_plus_one = n1.digits.size() - n2.digits.size() + 1;
-            std::vector<base_int> lower_bound_for_res_digits(number_of_leading_zeros_plus_one);
-            lower_bound_for_res_digits.back() = tmp_res >> BigInt::half_base_digits;
-            if (lower_bound_for_res_digits.size() > 1)
-                *(lower_bound_for_res_digits.end()-2) = tmp_res & BigInt::leading_mask;
+    // acc = acc + {ap, an} * {bp, bn} with the sign 'negative' for the product; an, bn >= 1,
+    // and neither operand may live in the limbs of 'acc'
+    static void addmul_limbs(BigInt& acc, const mpn::limb_t* ap, size_t an, const mpn::limb_t* bp, size_t bn, bool negative)
+    {
+        const size_t acc_size = acc.size();
+        const bool acc_negative = acc.is_negative();
+        const size_t product_size = an + bn;
+        const bool rows = bn <= addmul_row_limbs;
+
+        // the product, unless it is accumulated row by row
+        const scratch_buffer product(rows ? 0 : product_size);
+        if (!rows)
+        {
+            const scratch_buffer scratch(an >= bn ? mpn::mul_scratch_size(an, bn) : mpn::mul_scratch_size(bn, an));
+            if (an >= bn)
+                mpn::mul(product.data(), ap, an, bp, bn, scratch.data());
+            else
+                mpn::mul(product.data(), bp, bn, ap, an, scratch.data());
+        }
 
-            // remove leading zeros
-            while (lower_bound_for_res_digits.size() > 0 && lower_bound_for_res_digits.back() == 0)
-                lower_bound_for_res_digits.pop_back();
+        if (acc_size == 0 || acc_negative == negative)
+        {
+            // add the magnitudes; one more limb for the carry
+            const size_t n = std::max(acc_size, product_size) + 1;
+            mpn::limb_t* rp = acc.limbs_write(n);
+            if (rows)
+                for (size_t idx = 0; idx < bn; ++idx)
+                {
+                    const mpn::limb_t carry = mpn::addmul_1(rp + idx, ap, an, bp[idx]);
+                    mpn::add_1(rp + idx + an, rp + idx + an, n - idx - an, carry);
+                }
+            else
+                mpn::add(rp, rp, n, product.data(), product_size);
+            acc.limbs_finish(n, negative);
+        } else {
+            // subtract the magnitudes modulo b^n; a borrow out of the top means the product was larger
+            const size_t n = std::max(acc_size, product_size);
+            mpn::limb_t* rp = acc.limbs_write(n);
+            mpn::limb_t borrow = 0;
+            if (rows)
+                for (size_t idx = 0; idx < bn; ++idx)
+                {
+                    const mpn::limb_t row_borrow = mpn::submul_1(rp + idx, ap, an, bp[idx]);
+                    borrow |= mpn::sub_1(rp + idx + an, rp + idx + an, n - idx - an, row_borrow);
+                }
+            else
+                borrow = mpn::sub(rp, rp, n, product.data(), product_size);
 
-            // The division result is definitely larger than zero since we catch that case right away in "if (n2 > n1)".
-            if (lower_bound_for_res_digits.empty())
-                lower_bound_for_res_digits.push_back(1);
+            bool res_negative = acc_negative;
+            if (borrow)
+            {
+                // b^n - {rp, n} by the two's complement
+                for (size_t idx = 0; idx < n; ++idx)
+                    rp[idx] = ~rp[idx] & mpn::limb_mask;
+                mpn::add_1(rp, rp, n, 1);
+                res_negative = negative;
+            }
+            acc.limbs_finish(n, res_negative);
+        }
+    }
+
+    void addmul(BigInt& acc, const BigInt& a, const BigInt& b)
+    {
+        if (a == 0 || b == 0)
+            return;
+        if (&acc == &a || &acc == &b)
+        {
+            acc = acc + a * b;
+            return;
+        }
 
-            const BigInt lower_bound_for_res(false,std::move(lower_bound_for_res_digits));
-            return lower_bound_for_res + (n1-n2*lower_bound_for_res) / n2;
+        const BigInt& u = a.size() >= b.size() ? a : b;
+        const BigInt& v = a.size() >= b.size() ? b : a;
+        addmul_limbs(acc, u.limbs_read(), u.size(), v.limbs_read(), v.size(), a.is_negative() != b.is_negative());
+    }
 
+    void submul(BigInt& acc, const BigInt& a, const BigInt& b)
+    {
+        if (a == 0 || b == 0)
+            return;
+        if (&acc == &a || &acc == &b)
+        {
+            acc = acc - a * b;
+            return;
+        }
+
+        const BigInt& u = a.size() >= b.size() ? a : b;
+        const BigInt& v = a.size() >= b.size() ? b : a;
+        addmul_limbs(acc, u.limbs_read(), u.size(), v.limbs_read(), v.size(), a.is_negative() == b.is_negative());
+    }
+
+    void addmul_detail::addmul_word(BigInt& acc, const BigInt& a, unsigned long long magnitude, bool negative)
+    {
+        if (a == 0 || magnitude == 0)
+            return;
+        if (&acc == &a)
+        {
+            const BigInt copy(a, a.resource());
+            addmul_word(acc, copy, magnitude, negative);
+            return;
         }
 
+        mpn::limb_t limbs[addmul_row_limbs];
+        size_t n = 0;
+        for ( ; magnitude != 0; magnitude >>= mpn::limb_bits)
+            limbs[n++] = magnitude & mpn::limb_mask;
+        addmul_limbs(acc, a.limbs_read(), a.size(), limbs, n, a.is_negative() != negative);
     }
 
 }
@@ -0,0 +1,168 @@
+#include "../exread/combinatorics.hpp"
+#include "../exread/product.hpp"
+
+#include <vector> // std::vector
+
+namespace exread {
+
+    using ulonglong = unsigned long long;
+
+    // n! fits into an unsigned long long up to this n
+    static constexpr unsigned long factorial_word_limit = 20;
+    // binomial(n, k) with k < n / binomial_sieve_ratio is computed as falling factorial
+    // divided by k!, which avoids sieving up to n for small k
+    static constexpr unsigned long binomial_sieve_ratio = 16;
+
+    /*
+     *  primes
+     */
+    // all primes <= n by the sieve of Eratosthenes on the odd numbers
+    static std::vector<unsigned long> primes_up_to(unsigned long n)
+    {
+        std::vector<unsigned long> primes;
+        if (n < 2)
+            return primes;
+        primes.push_back(2);
+
+        // composite[idx] refers to 2*idx + 1
+        std::vector<bool> composite(n / 2 + 1, false);
+        for (unsigned long idx = 1; 2*idx + 1 <= n; ++idx)
+        {
+            if (composite[idx])
+                continue;
+            const unsigned long p = 2*idx + 1;
+            primes.push_back(p);
+            if (p <= n / p)
+                for (unsigned long multiple = p * p; multiple <= n; multiple += 2*p)
+                    composite[multiple / 2] = true;
+        }
+        return primes;
+    }
+
+    /*
+     *  factor collection
+     */
+    // collects factors, multiplying them into machine words while they fit
+    class factor_list
+    {
+        private:
+
+            std::vector<ulonglong> words;
+
+        public:
+
+            void push(ulonglong x)
+            {
+                if (!words.empty() && words.back() <= std::numeric_limits<ulonglong>::max() / x)
+                    words.back() *= x;
+                else
+                    words.push_back(x);
+            };
+
+            // balanced product of the words
+            BigInt product() const
+            {
+                const std::vector<BigInt> leaves(words.begin(), words.end());
+                return exread::product(leaves.begin(), leaves.end());
+            };
+    };
+
+    /*
+     *  factorial by prime swing
+     *
+     *  n! == (floor(n/2)!)^2 * swing(n), where the swing n! / (floor(n/2)!)^2
+     *  contains every prime p <= n with the exponent sum_i (floor(n / p^i) mod 2).
+     */
+    static BigInt swing(unsigned long n, const std::vector<unsigned long>& primes)
+    {
+        factor_list factors;
+        for (unsigned long p : primes)
+        {
+            if (p > n)
+                break;
+
+            // p^exponent <= n, so the factor fits into a word
+            ulonglong factor = 1;
+            for (unsigned long q = n / p; q > 0; q /= p)
+                if (q & 1)
+                    factor *= p;
+            if (factor > 1)
+                factors.push(factor);
+        }
+        return factors.product();
+    }
+
+    static BigInt factorial(unsigned long n, const std::vector<unsigned long>& primes)
+    {
+        if (n <= factorial_word_limit)
+        {
+            ulonglong res = 1;
+            for (unsigned long idx = 2; idx <= n; ++idx)
+                res *= idx;
+            return res;
+        }
+
+        const BigInt half = factorial(n / 2, primes);
+        return half * half * swing(n, primes);
+    }
+
+    BigInt factorial(unsigned long n)
+    {
+        if (n <= factorial_word_limit)
+            return factorial(n, {});
+        return factorial(n, primes_up_to(n));
+    }
+
+    /*
+     *  binomial coefficients
+     *
+     *  By Kummer's theorem, the exponent of p in binomial(n, k) is the number
+     *  of borrows when subtracting k from n in base p.
+     */
+    BigInt binomial(unsigned long n, unsigned long k)
+    {
+        if (k > n)
+            return 0;
+        if (k > n - k)
+            k = n - k;
+        if (k == 0)
+            return 1;
+
+        if (k < n / binomial_sieve_ratio)
+        {
+            factor_list factors;
+            for (unsigned long idx = 0; idx < k; ++idx)
+                factors.push(n - idx);
+            return factors.product() / factorial(k);
+        }
+
+        factor_list factors;
+        for (unsigned long p : primes_up_to(n))
+        {
+            // p^exponent <= n, so the factor fits into a word
+            ulonglong factor = 1;
+            bool borrow = false;
+            for (unsigned long nn = n, kk = k; nn > 0; nn /= p, kk /= p)
+            {
+                borrow = nn % p < kk % p + borrow;
+                if (borrow)
+                    factor *= p;
+            }
+            if (factor > 1)
+                factors.push(factor);
+        }
+        return factors.product();
+    }
+
+    /*
+     *  primorial
+     */
+    BigInt primorial(unsigned long n)
+    {
+        factor_list factors;
+        for (unsigned long p : primes_up_to(n))
+            factors.push(p);
+        return factors.product();
+    }
+
+}
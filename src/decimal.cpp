@@ -0,0 +1,391 @@
+#include "../exread/decimal.hpp"
+#include "../exread/bigfloat.hpp"
+
+#include <algorithm> // std::max, std::min
+#include <cmath> // HUGE_VAL, std::ldexp
+#include <limits> // std::numeric_limits
+#include <vector> // std::vector
+
+namespace exread {
+
+    using ulonglong = unsigned long long;
+
+    // larger exponents are rejected (or saturated), such that adding the digit counts cannot overflow
+    static constexpr long max_decimal_exponent = std::numeric_limits<long>::max() / 4;
+
+    static bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /*
+     *  syntax
+     */
+    // the value is (-1)^negative * d * 10^exponent, where d is the integer made of the significant
+    // digits at the positions [first, last] of the string, skipping a decimal point
+    struct decimal_parts
+    {
+        bool negative;
+        bool zero; // no significant digits
+        size_t first, last;
+        size_t count; // number of significant digits
+        long exponent;
+        bool saturated; // the exponent is out of range and has been clamped
+    };
+
+    static decimal_parts scan_decimal(const std::string& s, const char* name)
+    {
+        const auto invalid = [&s, name]() { return std::invalid_argument(std::string(name) + "(\"" + s + "\")"); };
+
+        decimal_parts parts{false, true, 0, 0, 0, 0, false};
+        size_t pos = 0;
+        parts.negative = pos < s.size() && s[pos] == '-';
+        if (pos < s.size() && (s[pos] == '-' || s[pos] == '+'))
+            ++pos;
+
+        size_t digit_count = 0;
+        size_t point = std::string::npos;
+        for ( ; pos < s.size(); ++pos)
+        {
+            if (is_digit(s[pos]))
+            {
+                ++digit_count;
+                if (s[pos] != '0')
+                {
+                    if (parts.zero)
+                        parts.first = pos;
+                    parts.last = pos;
+                    parts.zero = false;
+                }
+            } else if (s[pos] == '.' && point == std::string::npos) {
+                point = pos;
+            } else {
+                break;
+            }
+        }
+        if (digit_count == 0)
+            throw invalid();
+        if (point == std::string::npos)
+            point = pos;
+
+        long exponent = 0;
+        if (pos < s.size())
+        {
+            if (s[pos] != 'e' && s[pos] != 'E')
+                throw invalid();
+            ++pos;
+            const bool exponent_negative = pos < s.size() && s[pos] == '-';
+            if (pos < s.size() && (s[pos] == '-' || s[pos] == '+'))
+                ++pos;
+            if (pos == s.size())
+                throw invalid();
+            for ( ; pos < s.size(); ++pos)
+            {
+                if (!is_digit(s[pos]))
+                    throw invalid();
+                if (exponent > max_decimal_exponent / 10)
+                    parts.saturated = true;
+                else
+                    exponent = exponent * 10 + (s[pos] - '0');
+            }
+            if (parts.saturated)
+                exponent = max_decimal_exponent;
+            if (exponent_negative)
+                exponent = -exponent;
+        }
+
+        if (parts.zero)
+            return parts;
+
+        // the weight of the last significant digit
+        if (s.size() > size_t(max_decimal_exponent))
+            parts.saturated = true;
+        const long last_weight = parts.last < point ? long(point - parts.last) - 1 : -long(parts.last - point);
+        parts.exponent = exponent + last_weight;
+        parts.count = parts.last - parts.first + 1 - (parts.first < point && point < parts.last ? 1 : 0);
+        return parts;
+    }
+
+    /*
+     *  exact reading
+     */
+    DecimalNumber read_decimal(const std::string& s, memory_resource* resource)
+    {
+        const decimal_parts parts = scan_decimal(s, "read_decimal");
+        if (parts.saturated)
+            throw std::invalid_argument("read_decimal: exponent out of range");
+        if (parts.zero)
+            return {BigInt(0, resource), 0};
+
+        // the significant digits without the decimal point, in the format of BigInt(const std::string&)
+        std::string digits = parts.negative ? "-" : "";
+        digits.reserve(digits.size() + parts.count);
+        for (size_t pos = parts.first; pos <= parts.last; ++pos)
+            if (s[pos] != '.')
+                digits.push_back(s[pos]);
+        return {BigInt(digits, resource), parts.exponent};
+    }
+
+    Rational to_rational(const DecimalNumber& d)
+    {
+        const unsigned long magnitude = d.exponent < 0 ? -(unsigned long)(d.exponent) : d.exponent;
+        if (magnitude > std::numeric_limits<unsigned>::max())
+            throw std::invalid_argument("to_rational: exponent out of range");
+
+        const BigInt power = pow(BigInt(10, d.significand.resource()), unsigned(magnitude));
+        if (d.exponent >= 0)
+            return Rational(d.significand * power);
+        return Rational(d.significand, power);
+    }
+
+    Rational read_rational(const std::string& s)
+    {
+        return to_rational(read_decimal(s));
+    }
+
+    /*
+     *  reading doubles
+     *
+     *  1. Clinger's fast path: a significand below 2^53 and a power of ten
+     *     up to 10^22 are both exact doubles, so one IEEE multiplication or
+     *     division rounds correctly.
+     *  2. Eisel-Lemire: the first 19 significant digits w are multiplied by
+     *     a 128 bit truncation T of the power of five (the power of two is
+     *     exact), which yields w * 10^q up to an error below w units of the
+     *     192 bit product. If both ends of that interval (and of the one for
+     *     w + 1 if digits were cut off) round to the same double, so does
+     *     the exact value.
+     *  3. Otherwise, the exact value is rounded with BigFloat.
+     */
+    static constexpr int min_power_of_five = -342; // w * 10^q < 2^-1075 below
+    static constexpr int max_power_of_five = 308; // w * 10^q >= 2^1024 above
+    static constexpr size_t max_fast_digits = 19; // 10^19 < 2^64
+
+    // 5^q == (hi * 2^64 + lo + delta) * 2^shift with 2^127 <= hi * 2^64 + lo < 2^128 and
+    // delta in [0, 1), and delta == 0 if 'exact'
+    struct power_of_five
+    {
+        ulonglong hi, lo;
+        long shift;
+        bool exact;
+    };
+
+    static ulonglong low_word(const BigInt& n)
+    {
+        ulonglong res = 0;
+        for (size_t idx = 0; idx < n.size() && idx * mpn::limb_bits < 64; ++idx)
+            res |= ulonglong(n.limbs_read()[idx]) << (idx * mpn::limb_bits);
+        return res;
+    }
+
+    static std::vector<power_of_five> make_powers_of_five()
+    {
+        std::vector<power_of_five> table;
+        for (int q = min_power_of_five; q <= max_power_of_five; ++q)
+        {
+            const BigInt power = pow(BigInt(5), unsigned(q < 0 ? -q : q));
+            const long length = long(power.bit_length());
+            BigInt t;
+            long shift = 0;
+            if (q >= 0)
+            {
+                shift = length - 128;
+                t = shift >= 0 ? power >> size_t(shift) : power << size_t(-shift);
+            } else {
+                // 2^k / 5^-q lies in (2^127, 2^128) for k = 127 + length
+                shift = -(127 + length);
+                t = (BigInt(1) << size_t(-shift)) / power;
+            }
+            table.push_back({low_word(t >> 64), low_word(t), shift, q >= 0 && shift <= 0});
+        }
+        return table;
+    }
+
+    static const power_of_five& get_power_of_five(int q)
+    {
+        static const std::vector<power_of_five> table = make_powers_of_five();
+        return table[size_t(q - min_power_of_five)];
+    }
+
+    // 192 bit unsigned integer, least significant word first
+    struct uint192
+    {
+        ulonglong words[3];
+
+        bool bit(size_t idx) const { return idx < 192 && ((words[idx / 64] >> (idx % 64)) & 1); }
+
+        size_t bit_length() const
+        {
+            for (size_t idx = 3; idx > 0; --idx)
+                for (size_t b = 64; b > 0; --b)
+                    if ((words[idx-1] >> (b - 1)) & 1)
+                        return (idx - 1) * 64 + b;
+            return 0;
+        }
+
+        // the bits from 'shift' upwards, of which there are at most 64
+        ulonglong shifted(size_t shift) const
+        {
+            if (shift >= 192)
+                return 0;
+            const size_t word = shift / 64;
+            const size_t offset = shift % 64;
+            ulonglong res = words[word] >> offset;
+            if (offset != 0 && word + 1 < 3)
+                res |= words[word + 1] << (64 - offset);
+            return res;
+        }
+
+        // whether any of the bits below 'shift' is set
+        bool any_below(size_t shift) const
+        {
+            for (size_t idx = 0; idx < 3 && idx * 64 < shift; ++idx)
+            {
+                const size_t bits = std::min<size_t>(shift - idx * 64, 64);
+                const ulonglong mask = bits == 64 ? ~0ull : (1ull << bits) - 1;
+                if (words[idx] & mask)
+                    return true;
+            }
+            return false;
+        }
+
+        void add(ulonglong n)
+        {
+            words[0] += n;
+            if (words[0] < n && ++words[1] == 0)
+                ++words[2];
+        }
+    };
+
+    // the full product a * b as {low, high}
+    static void mul_words(ulonglong a, ulonglong b, ulonglong& low, ulonglong& high)
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 uint128;
+        const uint128 product = uint128(a) * b;
+        low = ulonglong(product);
+        high = ulonglong(product >> 64);
+#else
+        const ulonglong a0 = a & 0xffffffffull, a1 = a >> 32;
+        const ulonglong b0 = b & 0xffffffffull, b1 = b >> 32;
+        const ulonglong p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        const ulonglong middle = (p00 >> 32) + (p01 & 0xffffffffull) + (p10 & 0xffffffffull);
+        low = (middle << 32) | (p00 & 0xffffffffull);
+        high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+#endif
+    }
+
+    static uint192 mul_power(ulonglong w, const power_of_five& t)
+    {
+        ulonglong lo_lo, lo_hi, hi_lo, hi_hi;
+        mul_words(w, t.lo, lo_lo, lo_hi);
+        mul_words(w, t.hi, hi_lo, hi_hi);
+        uint192 res{{lo_lo, hi_lo, hi_hi}};
+        res.words[1] += lo_hi;
+        if (res.words[1] < lo_hi)
+            ++res.words[2];
+        return res;
+    }
+
+    // x * 2^exponent for x > 0 rounded to the nearest double, ties to even
+    static double round_to_double(const uint192& x, long exponent)
+    {
+        constexpr long mantissa_bits = std::numeric_limits<double>::digits;
+        constexpr long min_exponent = std::numeric_limits<double>::min_exponent - 1; // of the leading bit of normal numbers
+
+        // fewer mantissa bits for subnormal results
+        const long length = long(x.bit_length());
+        const long top = exponent + length - 1;
+        const long bits = top >= min_exponent ? mantissa_bits : top - min_exponent + mantissa_bits;
+        const size_t shift = size_t(length - bits); // positive, as x has at least 128 bits
+
+        ulonglong mantissa = x.shifted(shift);
+        const bool half = x.bit(shift - 1);
+        if (half && ((mantissa & 1) != 0 || x.any_below(shift - 1)))
+            ++mantissa;
+        return std::ldexp(double(mantissa), int(exponent + long(shift)));
+    }
+
+    // the double nearest to w * 10^q for all w in [w_lo, w_hi], if they all round alike
+    static bool eisel_lemire(ulonglong w_lo, ulonglong w_hi, int q, double& res)
+    {
+        const power_of_five& t = get_power_of_five(q);
+        const uint192 lo = mul_power(w_lo, t);
+        uint192 hi = mul_power(w_hi, t);
+        if (!t.exact)
+            hi.add(w_hi);
+
+        // 10^q == 5^q * 2^q
+        res = round_to_double(lo, t.shift + q);
+        return round_to_double(hi, t.shift + q) == res;
+    }
+
+    // the double nearest to d > 0 by exact arithmetic
+    static double round_exact(const DecimalNumber& d)
+    {
+        const BigFloat significand(d.significand, std::max<size_t>(d.significand.bit_length(), 1));
+        const BigInt power = pow(BigInt(10), unsigned(d.exponent < 0 ? -d.exponent : d.exponent));
+        const BigFloat scale(power, std::max<size_t>(power.bit_length(), 1));
+        const auto value = [&](size_t prec, RoundingMode rnd) {
+            return d.exponent < 0 ? div(significand, scale, prec, rnd) : mul(significand, scale, prec, rnd);
+        };
+
+        // the binade, which rounding toward zero preserves
+        const BigFloat truncated = value(2, RoundingMode::toward_zero);
+        const long top = truncated.exponent() + long(truncated.mantissa().bit_length()) - 1;
+        constexpr long min_exponent = std::numeric_limits<double>::min_exponent - 1;
+        constexpr long mantissa_bits = std::numeric_limits<double>::digits;
+        const long bits = top >= min_exponent ? mantissa_bits : top - min_exponent + mantissa_bits;
+        if (bits < 0)
+            return 0.;
+        if (bits == 0) // in [2^-1075, 2^-1074): the tie 2^-1075 rounds to zero
+        {
+            const BigFloat up = value(1, RoundingMode::upward);
+            return up.exponent() > top ? std::ldexp(1., int(top + 1)) : 0.;
+        }
+
+        const BigFloat res = value(size_t(bits), RoundingMode::nearest_even);
+        return std::ldexp(res.mantissa().to_double(), int(res.exponent()));
+    }
+
+    double read_double(const std::string& s)
+    {
+        const decimal_parts parts = scan_decimal(s, "read_double");
+        const double sign = parts.negative ? -1. : 1.;
+        if (parts.zero)
+            return sign * 0.;
+
+        // the first up to 19 significant digits w; the value lies in [w, w + 1) * 10^q
+        ulonglong w = 0;
+        size_t taken = 0;
+        for (size_t pos = parts.first; pos <= parts.last && taken < max_fast_digits; ++pos)
+        {
+            if (s[pos] == '.')
+                continue;
+            w = w * 10 + ulonglong(s[pos] - '0');
+            ++taken;
+        }
+        const bool cut = taken < parts.count;
+        const long q = parts.exponent + long(parts.count - taken);
+
+        if (q < min_power_of_five)
+            return sign * 0.;
+        if (q > max_power_of_five)
+            return sign * HUGE_VAL;
+
+        static const double exact_powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        if (!cut && w <= (1ull << std::numeric_limits<double>::digits) && q >= -22 && q <= 22)
+            return sign * (q >= 0 ? double(w) * exact_powers_of_ten[q] : double(w) / exact_powers_of_ten[-q]);
+
+        double res = 0.;
+        if (eisel_lemire(w, cut ? w + 1 : w, int(q), res))
+            return sign * res;
+
+        DecimalNumber d = read_decimal(s);
+        if (parts.negative)
+            d.significand = -d.significand;
+        return sign * round_exact(d);
+    }
+
+}
@@ -0,0 +1,537 @@
+#include "../exread/numtheory.hpp"
+#include "scratch.hpp"
+
+#include <algorithm> // std::copy, std::fill, std::max, std::min, std::swap
+#include <utility> // std::move
+
+namespace exread {
+
+    using mpn::limb_t;
+    using ulonglong = unsigned long long;
+
+    // operands of at most this many limbs fit into an unsigned long long and use the binary algorithm
+    static constexpr size_t gcd_binary_limbs = std::numeric_limits<ulonglong>::digits / mpn::limb_bits;
+    // operands of more than this many limbs are reduced by the half-gcd algorithm
+    static constexpr size_t gcd_hgcd_threshold = 200;
+
+    /*
+     *  binary gcd on machine words
+     */
+    static int count_trailing_zeros(ulonglong x)
+    {
+        assert(x != 0);
+
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#else
+        int count = 0;
+        for ( ; (x & 1) == 0; x >>= 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    static ulonglong binary_gcd(ulonglong u, ulonglong v)
+    {
+        if (u == 0)
+            return v;
+        if (v == 0)
+            return u;
+
+        const int shift = count_trailing_zeros(u | v);
+        u >>= count_trailing_zeros(u);
+        do
+        {
+            v >>= count_trailing_zeros(v);
+            if (u > v)
+                std::swap(u, v);
+            v -= u;
+        } while (v != 0);
+        return u << shift;
+    }
+
+    static ulonglong to_ulonglong(const limb_t* up, size_t n)
+    {
+        assert(n <= gcd_binary_limbs);
+
+        ulonglong res = 0;
+        for (size_t idx = n; idx > 0; --idx)
+            res = (res << mpn::limb_bits) | up[idx-1];
+        return res;
+    }
+
+    /*
+     *  Lehmer's algorithm (Knuth, TAOCP vol. 2, 4.5.2, algorithm L)
+     */
+    // cofactors of a sequence of Euclidean steps: (u', v') = (a*u + b*v, c*u + d*v)
+    struct lehmer_cofactors
+    {
+        long long a, b, c, d;
+        int det; // a*d - b*c, either 1 or -1
+    };
+
+    // simulate Euclidean steps on the leading bits x >= y of two numbers, truncated at the same
+    // position, as long as the quotients are certain to agree with those of the full numbers;
+    // b == 0 if not even the first quotient is certain; all cofactors are at most limb_mask
+    static lehmer_cofactors lehmer_step(long long x, long long y)
+    {
+        lehmer_cofactors res = {1, 0, 0, 1, 1};
+        while (y + res.c > 0 && y + res.d > 0)
+        {
+            const long long q = (x + res.a) / (y + res.c);
+            if (q != (x + res.b) / (y + res.d))
+                break;
+
+            const long long c = res.a - q * res.c;
+            const long long d = res.b - q * res.d;
+            const long long max_cofactor = mpn::limb_mask;
+            if (c > max_cofactor || -c > max_cofactor || d > max_cofactor || -d > max_cofactor)
+                break;
+
+            res.a = res.c;
+            res.b = res.d;
+            res.c = c;
+            res.d = d;
+            res.det = -res.det;
+
+            const long long r = x - q * y;
+            x = y;
+            y = r;
+        }
+        return res;
+    }
+
+    // the leading 2*limb_bits bits of {up, un} and the bits of {vp, vn} at the same position; un >= 3
+    static void leading_bits(long long& x, long long& y, const limb_t* up, size_t un, const limb_t* vp, size_t vn)
+    {
+        assert(un >= 3 && un >= vn);
+
+        const auto limb = [](const limb_t* p, size_t n, size_t idx) { return idx < n ? ulonglong(p[idx]) : ulonglong(0); };
+        const int shift = mpn::count_leading_zeros(up[un-1]);
+        const ulonglong u = (limb(up, un, un-1) << (2*mpn::limb_bits)) | (limb(up, un, un-2) << mpn::limb_bits) | limb(up, un, un-3);
+        const ulonglong v = (limb(vp, vn, un-1) << (2*mpn::limb_bits)) | (limb(vp, vn, un-2) << mpn::limb_bits) | limb(vp, vn, un-3);
+        x = (u << shift) >> mpn::limb_bits;
+        y = (v << shift) >> mpn::limb_bits;
+    }
+
+    // {rp, n} = p*|f| - q*|g| with f >= 0 >= g, or q*|g| - p*|f| with g >= 0 >= f;
+    // the result must be nonnegative and less than b^n
+    static void combine(limb_t* rp, const limb_t* pp, long long f, const limb_t* qp, long long g, size_t n)
+    {
+        if (f < 0 || g > 0)
+        {
+            std::swap(pp, qp);
+            std::swap(f, g);
+        }
+        assert(f >= 0 && g <= 0);
+
+        const limb_t high = mpn::mul_1(rp, pp, n, limb_t(f));
+        const limb_t borrow = mpn::submul_1(rp, qp, n, limb_t(-g));
+        assert(high == borrow);
+        (void) high;
+        (void) borrow;
+    }
+
+    // {up, n} as a BigInt
+    static BigInt from_limbs(const limb_t* up, size_t n, memory_resource* resource)
+    {
+        BigInt res(resource);
+        std::copy(up, up + n, res.limbs_write(n));
+        res.limbs_finish(n);
+        return res;
+    }
+
+    // res = f*x + g*y for |f|, |g| <= limb_mask; reuses the limbs of res, which must not be x or y
+    static void combine_signed(BigInt& res, long long f, const BigInt& x, long long g, const BigInt& y)
+    {
+        const bool neg_fx = (f < 0) != x.is_negative();
+        const bool neg_gy = (g < 0) != y.is_negative();
+        const size_t xn = x.size();
+        const size_t yn = y.size();
+        const size_t n = std::max(xn, yn) + 1;
+
+        limb_t* rp = res.limbs_write(n);
+        rp[xn] = mpn::mul_1(rp, x.limbs_read(), xn, limb_t(f < 0 ? -f : f));
+        std::fill(rp + xn + 1, rp + n, 0);
+
+        if (neg_fx == neg_gy)
+        {
+            const limb_t carry = mpn::addmul_1(rp, y.limbs_read(), yn, limb_t(g < 0 ? -g : g));
+            mpn::add_1(rp + yn, rp + yn, n - yn, carry);
+            res.limbs_finish(n, neg_fx);
+            return;
+        }
+
+        limb_t borrow = mpn::submul_1(rp, y.limbs_read(), yn, limb_t(g < 0 ? -g : g));
+        borrow = mpn::sub_1(rp + yn, rp + yn, n - yn, borrow);
+        if (borrow)
+        {
+            // |g*y| > |f*x|: negate the two's complement
+            for (size_t idx = 0; idx < n; ++idx)
+                rp[idx] = ~rp[idx] & mpn::limb_mask;
+            mpn::add_1(rp, rp, n, 1);
+        }
+        res.limbs_finish(n, borrow ? neg_gy : neg_fx);
+    }
+
+    // cofactors of the first original operand for the current pair (u, v): u == s0 * a (mod b) and
+    // v == s1 * a (mod b), transformed along with every reduction of (u, v)
+    struct cofactor_pair
+    {
+        BigInt s0, s1;
+        BigInt next0, next1; // storage reused by lehmer_transform
+
+        cofactor_pair(int s0, int s1) : s0(s0), s1(s1), next0(), next1() {};
+
+        // (u, v) = (v, u - q*v)
+        void euclid(const BigInt& q)
+        {
+            BigInt s = s0 - q * s1;
+            s0 = std::move(s1);
+            s1 = std::move(s);
+        }
+
+        // (u, v) = (a*u + b*v, c*u + d*v)
+        void transform(const BigInt& a, const BigInt& b, const BigInt& c, const BigInt& d)
+        {
+            BigInt s = a * s0 + b * s1;
+            s1 = c * s0 + d * s1;
+            s0 = std::move(s);
+        }
+
+        // as transform for single-limb cofactors, without allocations once the storage has grown
+        void lehmer_transform(long long a, long long b, long long c, long long d)
+        {
+            combine_signed(next0, a, s0, b, s1);
+            combine_signed(next1, c, s0, d, s1);
+            std::swap(s0, next0);
+            std::swap(s1, next1);
+        }
+    };
+
+    // gcd of a >= b >= 0 with a > 0; with 'cofactors', the cofactor of the gcd ends up in cofactors->s0
+    static BigInt lehmer_gcd(const BigInt& a, const BigInt& b, cofactor_pair* cofactors)
+    {
+        size_t un = a.size();
+        size_t vn = b.size();
+
+        // u and v are kept zero-padded to un limbs
+        const scratch_buffer u_buffer(un), v_buffer(un), s_buffer(un), t_buffer(un);
+        const scratch_buffer q_buffer(un), divrem_scratch(mpn::divrem_scratch_size(un, un));
+        limb_t* up = u_buffer.data();
+        limb_t* vp = v_buffer.data();
+        limb_t* sp = s_buffer.data();
+        limb_t* tp = t_buffer.data();
+        std::copy(a.limbs_read(), a.limbs_read() + un, up);
+        std::copy(b.limbs_read(), b.limbs_read() + vn, vp);
+        std::fill(vp + vn, vp + un, 0);
+
+        while (vn > gcd_binary_limbs)
+        {
+            long long x, y;
+            leading_bits(x, y, up, un, vp, vn);
+            const lehmer_cofactors step = lehmer_step(x, y);
+
+            if (step.b == 0)
+            {
+                // full division step: (u, v) = (v, u mod v)
+                mpn::divrem(q_buffer.data(), sp, up, un, vp, vn, divrem_scratch.data());
+                if (cofactors)
+                    cofactors->euclid(from_limbs(q_buffer.data(), un - vn + 1, a.resource()));
+                std::swap(up, vp);
+                std::swap(vp, sp);
+                un = vn;
+                vn = mpn::normalized_size(vp, vn);
+                std::fill(vp + vn, vp + un, 0);
+                continue;
+            }
+
+            combine(sp, up, step.a, vp, step.b, un);
+            combine(tp, up, step.c, vp, step.d, un);
+            if (cofactors)
+                cofactors->lehmer_transform(step.a, step.b, step.c, step.d);
+            std::swap(up, sp);
+            std::swap(vp, tp);
+            un = mpn::normalized_size(up, un);
+            vn = mpn::normalized_size(vp, un);
+        }
+
+        if (vn == 0)
+            return from_limbs(up, un, a.resource());
+
+        // v fits into a machine word; a division step brings u there too
+        ulonglong u = to_ulonglong(vp, vn);
+        ulonglong v;
+        if (un > gcd_binary_limbs)
+        {
+            if (vn == 1)
+            {
+                v = mpn::divrem_1(q_buffer.data(), up, un, vp[0]);
+            } else {
+                mpn::divrem(q_buffer.data(), sp, up, un, vp, vn, divrem_scratch.data());
+                v = to_ulonglong(sp, vn);
+            }
+            if (cofactors)
+                cofactors->euclid(from_limbs(q_buffer.data(), un - vn + 1, a.resource()));
+        } else {
+            v = u;
+            u = to_ulonglong(up, un);
+        }
+
+        if (!cofactors)
+            return BigInt(binary_gcd(u, v), a.resource());
+
+        // plain Euclid, keeping track of the cofactors
+        while (v != 0)
+        {
+            const ulonglong q = u / v;
+            if (q <= mpn::limb_mask)
+                cofactors->lehmer_transform(0, 1, 1, -(long long)(q));
+            else
+                cofactors->euclid(BigInt(q));
+            const ulonglong r = u - q * v;
+            u = v;
+            v = r;
+        }
+        return BigInt(u, a.resource());
+    }
+
+    /*
+     *  half-gcd
+     *
+     *  hgcd reduces a > b by Euclidean steps until b has about half the bits of
+     *  a and returns the unimodular matrix M with (a, b) = M * (a', b'). Since
+     *  the leading bits of a and b determine the first quotients, the matrix
+     *  is computed recursively from the leading half of the bits and applied
+     *  to the full numbers, twice per call; hence the cost is O(M(n) log n)
+     *  instead of O(n^2). Any unimodular transformation preserves the gcd, so
+     *  occasional imprecise matrices only cost time and are fixed up.
+     */
+    struct hgcd_matrix
+    {
+        BigInt m00, m01, m10, m11;
+        int det; // either 1 or -1
+
+        hgcd_matrix() : m00(1), m01(0), m10(0), m11(1), det(1) {};
+        hgcd_matrix(BigInt m00, BigInt m01, BigInt m10, BigInt m11, int det) :
+            m00(std::move(m00)), m01(std::move(m01)), m10(std::move(m10)), m11(std::move(m11)), det(det) {};
+
+        bool is_identity() const { return m01 == 0 && m10 == 0; }
+
+        // this = this * other
+        void multiply(const hgcd_matrix& other)
+        {
+            *this = hgcd_matrix(m00 * other.m00 + m01 * other.m10, m00 * other.m01 + m01 * other.m11,
+                                m10 * other.m00 + m11 * other.m10, m10 * other.m01 + m11 * other.m11,
+                                det * other.det);
+        }
+    };
+
+    // (a, b) = m^-1 * (a, b), normalized to a >= b >= 0 by adjusting the columns of m;
+    // leaves everything untouched and returns false unless a decreases
+    static bool apply_inverse(hgcd_matrix& m, BigInt& a, BigInt& b)
+    {
+        BigInt x = m.m11 * a - m.m01 * b;
+        BigInt y = m.m00 * b - m.m10 * a;
+        if (m.det < 0)
+        {
+            x = -x;
+            y = -y;
+        }
+
+        hgcd_matrix fixed = m;
+        if (x.is_negative())
+        {
+            x = -x;
+            fixed.m00 = -fixed.m00;
+            fixed.m10 = -fixed.m10;
+            fixed.det = -fixed.det;
+        }
+        if (y.is_negative())
+        {
+            y = -y;
+            fixed.m01 = -fixed.m01;
+            fixed.m11 = -fixed.m11;
+            fixed.det = -fixed.det;
+        }
+        if (x < y)
+        {
+            std::swap(x, y);
+            std::swap(fixed.m00, fixed.m01);
+            std::swap(fixed.m10, fixed.m11);
+            fixed.det = -fixed.det;
+        }
+        if (x >= a)
+            return false;
+
+        m = std::move(fixed);
+        a = std::move(x);
+        b = std::move(y);
+        return true;
+    }
+
+    // Lehmer matrix from the leading 2*limb_bits bits of a >= b
+    static hgcd_matrix lehmer_matrix(const BigInt& a, const BigInt& b)
+    {
+        const size_t shift = a.bit_length() - 2*mpn::limb_bits;
+        const BigInt a0 = a >> shift;
+        const BigInt b0 = b >> shift;
+        const long long x = (long long)(to_ulonglong(a0.limbs_read(), a0.size()));
+        const long long y = (long long)(to_ulonglong(b0.limbs_read(), b0.size()));
+        const lehmer_cofactors cof = lehmer_step(x, y);
+
+        // inverse of [[a, b], [c, d]]
+        return hgcd_matrix(cof.det * cof.d, -cof.det * cof.b, -cof.det * cof.c, cof.det * cof.a, cof.det);
+    }
+
+    // one Euclidean step (a, b) = (b, a mod b) recorded in m, unless the remainder has at most 's' bits
+    static bool euclid_step(BigInt& a, BigInt& b, hgcd_matrix* m, size_t s)
+    {
+        const BigInt q = a / b;
+        BigInt r = a - q * b;
+        if (r.bit_length() <= s)
+            return false;
+
+        if (m)
+            m->multiply(hgcd_matrix(q, 1, 1, 0, -1));
+        a = std::move(b);
+        b = std::move(r);
+        return true;
+    }
+
+    // reduce a >= b >= 0 until b has at most about half the bits of a; the transformation is
+    // accumulated in m unless m == nullptr
+    static void hgcd(BigInt& a, BigInt& b, hgcd_matrix* m)
+    {
+        const size_t n = a.bit_length();
+        const size_t s = n / 2 + 1;
+        // recursion pays off once the leading part is of about half the size at which gcd switches to hgcd
+        const size_t threshold_bits = gcd_hgcd_threshold * mpn::limb_bits / 2;
+
+        while (b.bit_length() > s)
+        {
+            // number of leading bits determining the quotients up to the target
+            const size_t na = a.bit_length();
+            const size_t bits = std::min(2 * (na - s), n / 2 + 1);
+
+            hgcd_matrix step;
+            if (bits >= threshold_bits)
+            {
+                BigInt a0 = a >> (na - bits);
+                BigInt b0 = b >> (na - bits);
+                hgcd(a0, b0, &step);
+            } else if (bits >= 2 * mpn::limb_bits) {
+                step = lehmer_matrix(a, b);
+            }
+
+            if (!step.is_identity() && apply_inverse(step, a, b))
+            {
+                if (m)
+                    m->multiply(step);
+                continue;
+            }
+            if (!euclid_step(a, b, m, s))
+                break;
+        }
+    }
+
+    // gcd of a >= b >= 0 with a > 0, see lehmer_gcd
+    static BigInt gcd_reduce(BigInt a, BigInt b, cofactor_pair* cofactors)
+    {
+        while (b.size() > gcd_hgcd_threshold)
+        {
+            if (cofactors)
+            {
+                // apply the accumulated matrix once, its entries being half the size of the cofactors
+                hgcd_matrix m;
+                hgcd(a, b, &m);
+                cofactors->transform(m.det * m.m11, -m.det * m.m01, -m.det * m.m10, m.det * m.m00);
+            } else {
+                hgcd(a, b, nullptr);
+            }
+            if (b == 0)
+                return a;
+
+            // a division step separates the sizes for the next reduction
+            const BigInt q = a / b;
+            BigInt r = a - q * b;
+            if (cofactors)
+                cofactors->euclid(q);
+            a = std::move(b);
+            b = std::move(r);
+        }
+        return lehmer_gcd(a, b, cofactors);
+    }
+
+    /*
+     *  gcd, lcm, gcdext, invert
+     */
+    BigInt gcd(const BigInt& n1, const BigInt& n2)
+    {
+        BigInt a = n1.is_negative() ? -n1 : BigInt(n1, n1.resource());
+        BigInt b = n2.is_negative() ? -n2 : BigInt(n2, n1.resource());
+        if (a < b)
+            std::swap(a, b);
+        if (a == 0)
+            return a;
+        if (a.size() <= gcd_binary_limbs)
+            return BigInt(binary_gcd(to_ulonglong(a.limbs_read(), a.size()), to_ulonglong(b.limbs_read(), b.size())), n1.resource());
+        return gcd_reduce(std::move(a), std::move(b), nullptr);
+    }
+
+    BigInt lcm(const BigInt& n1, const BigInt& n2)
+    {
+        if (n1 == 0 || n2 == 0)
+            return BigInt(n1.resource());
+
+        BigInt res = n1 / gcd(n1, n2) * n2;
+        return res.is_negative() ? -res : res;
+    }
+
+    GcdExtResult gcdext(const BigInt& n1, const BigInt& n2)
+    {
+        const BigInt a = n1.is_negative() ? -n1 : BigInt(n1, n1.resource());
+        const BigInt b = n2.is_negative() ? -n2 : BigInt(n2, n1.resource());
+        if (a == 0 && b == 0)
+            return {BigInt(n1.resource()), BigInt(n1.resource()), BigInt(n1.resource())};
+
+        // track the cofactor of a through the reduction of (max(a, b), min(a, b))
+        cofactor_pair cofactors = a >= b ? cofactor_pair(1, 0) : cofactor_pair(0, 1);
+        GcdExtResult res;
+        res.g = a >= b ? gcd_reduce(a, b, &cofactors) : gcd_reduce(b, a, &cofactors);
+
+        if (b == 0)
+        {
+            res.s = 1;
+        } else {
+            // the representative of s with the least absolute value, |s| <= b / (2g)
+            const BigInt period = b / res.g;
+            res.s = cofactors.s0 % period;
+            if (res.s.is_negative())
+                res.s = res.s + period;
+            if (res.s + res.s > period)
+                res.s = res.s - period;
+        }
+        res.t = b == 0 ? BigInt(n1.resource()) : (res.g - res.s * a) / b;
+
+        if (n1.is_negative())
+            res.s = -res.s;
+        if (n2.is_negative())
+            res.t = -res.t;
+        return res;
+    }
+
+    BigInt invert(const BigInt& n, const BigInt& modulus)
+    {
+        if (modulus == 0)
+            throw std::invalid_argument("invert: modulus must be nonzero");
+
+        const GcdExtResult res = gcdext(n, modulus);
+        if (res.g != 1)
+            throw std::invalid_argument("invert: not invertible");
+
+        const BigInt m = modulus.is_negative() ? -modulus : modulus;
+        return res.s.is_negative() ? res.s + m : res.s;
+    }
+
+}
@@ -0,0 +1,309 @@
+#include "../exread/memory.hpp"
+
+#include <algorithm> // std::max
+#include <atomic> // std::atomic
+#include <cassert> // assert
+#include <cstdint> // std::uintptr_t
+#include <cstring> // std::memcpy
+#include <new> // operator new, std::bad_alloc
+
+namespace exread {
+
+    // round 'n' up to a multiple of 'alignment' (a power of two)
+    static size_t align_up(size_t n, size_t alignment)
+    {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    /*
+     *  new_delete_resource
+     */
+    namespace {
+
+        class new_delete_memory_resource : public memory_resource
+        {
+            private:
+
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    assert(alignment <= max_align);
+                    (void) alignment;
+                    return ::operator new(bytes);
+                }
+
+                void do_deallocate(void* p, size_t, size_t) override
+                {
+                    ::operator delete(p);
+                }
+
+        };
+
+    }
+
+    memory_resource* new_delete_resource() noexcept
+    {
+        static new_delete_memory_resource resource;
+        return &resource;
+    }
+
+    /*
+     *  memory functions
+     */
+    static void* default_allocate(size_t bytes)
+    {
+        return ::operator new(bytes);
+    }
+
+    static void* default_reallocate(void* p, size_t old_bytes, size_t new_bytes)
+    {
+        void* result = ::operator new(new_bytes);
+        std::memcpy(result, p, std::min(old_bytes, new_bytes));
+        ::operator delete(p);
+        return result;
+    }
+
+    static void default_free(void* p, size_t)
+    {
+        ::operator delete(p);
+    }
+
+    static std::atomic<allocate_function> installed_allocate(default_allocate);
+    static std::atomic<reallocate_function> installed_reallocate(default_reallocate);
+    static std::atomic<free_function> installed_free(default_free);
+
+    void set_memory_functions(allocate_function allocate, reallocate_function reallocate, free_function free) noexcept
+    {
+        installed_allocate.store(allocate ? allocate : default_allocate);
+        installed_reallocate.store(reallocate ? reallocate : default_reallocate);
+        installed_free.store(free ? free : default_free);
+    }
+
+    void get_memory_functions(allocate_function* allocate, reallocate_function* reallocate, free_function* free) noexcept
+    {
+        if (allocate)
+            *allocate = installed_allocate.load();
+        if (reallocate)
+            *reallocate = installed_reallocate.load();
+        if (free)
+            *free = installed_free.load();
+    }
+
+    namespace {
+
+        class memory_functions_memory_resource : public memory_resource
+        {
+            private:
+
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    assert(alignment <= max_align);
+                    (void) alignment;
+                    void* result = installed_allocate.load()(bytes);
+                    if (result == nullptr)
+                        throw std::bad_alloc();
+                    return result;
+                }
+
+                void do_deallocate(void* p, size_t bytes, size_t) override
+                {
+                    installed_free.load()(p, bytes);
+                }
+
+        };
+
+    }
+
+    memory_resource* memory_functions_resource() noexcept
+    {
+        static memory_functions_memory_resource resource;
+        return &resource;
+    }
+
+    /*
+     *  default resource
+     */
+    static std::atomic<memory_resource*>& default_resource()
+    {
+        static std::atomic<memory_resource*> resource(memory_functions_resource());
+        return resource;
+    }
+
+    memory_resource* get_default_resource() noexcept
+    {
+        return default_resource().load(std::memory_order_acquire);
+    }
+
+    memory_resource* set_default_resource(memory_resource* resource) noexcept
+    {
+        if (resource == nullptr)
+            resource = memory_functions_resource();
+        return default_resource().exchange(resource, std::memory_order_acq_rel);
+    }
+
+    /*
+     *  monotonic_buffer_resource
+     */
+    monotonic_buffer_resource::monotonic_buffer_resource(memory_resource* upstream)
+        : monotonic_buffer_resource(nullptr, 0, upstream) {}
+
+    monotonic_buffer_resource::monotonic_buffer_resource(size_t initial_size, memory_resource* upstream)
+        : monotonic_buffer_resource(nullptr, 0, upstream)
+    {
+        next_size = std::max<size_t>(initial_size, 1);
+    }
+
+    monotonic_buffer_resource::monotonic_buffer_resource(void* buffer, size_t size, memory_resource* upstream)
+        : upstream(upstream ? upstream : get_default_resource()),
+          initial_buffer(buffer), initial_size(size), next_size(1024),
+          current(buffer), space(size), chunks(nullptr)
+    {}
+
+    void* monotonic_buffer_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        assert(alignment <= max_align);
+
+        // try the current buffer
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(current);
+        size_t padding = align_up(address, alignment) - address;
+        if (current == nullptr || padding + bytes > space)
+        {
+            // get a new buffer with geometric growth
+            const size_t header = align_up(sizeof(chunk), max_align);
+            const size_t chunk_bytes = header + std::max(next_size, bytes);
+            chunk* new_chunk = static_cast<chunk*>(upstream->allocate(chunk_bytes, max_align));
+            new_chunk->next = chunks;
+            new_chunk->bytes = chunk_bytes;
+            chunks = new_chunk;
+            next_size = 2 * std::max(next_size, bytes);
+
+            current = reinterpret_cast<char*>(new_chunk) + header;
+            space = chunk_bytes - header;
+            padding = 0;
+        }
+
+        void* result = static_cast<char*>(current) + padding;
+        current = static_cast<char*>(result) + bytes;
+        space -= padding + bytes;
+        return result;
+    }
+
+    void monotonic_buffer_resource::release()
+    {
+        while (chunks != nullptr)
+        {
+            chunk* next = chunks->next;
+            upstream->deallocate(chunks, chunks->bytes, max_align);
+            chunks = next;
+        }
+
+        current = initial_buffer;
+        space = initial_size;
+    }
+
+    /*
+     *  pool_resource
+     */
+    pool_resource::pool_resource(memory_resource* upstream)
+        : upstream(upstream ? upstream : get_default_resource()), chunks(nullptr), large_blocks(nullptr)
+    {
+        for (int idx = 0; idx < num_classes; ++idx)
+            free_lists[idx] = nullptr;
+    }
+
+    // index of the smallest size class holding 'bytes'; num_classes if there is none
+    static int size_class(size_t bytes, size_t min_block, int num_classes)
+    {
+        int idx = 0;
+        for (size_t block = min_block; block < bytes && idx < num_classes; block <<= 1)
+            ++idx;
+        return idx;
+    }
+
+    void* pool_resource::do_allocate(size_t bytes, size_t alignment)
+    {
+        assert(alignment <= max_align);
+        (void) alignment;
+
+        const int idx = size_class(bytes, min_block, num_classes);
+
+        // oversized blocks come straight from upstream
+        if (idx == num_classes)
+        {
+            const size_t header = align_up(sizeof(oversized), max_align);
+            oversized* block = static_cast<oversized*>(upstream->allocate(header + bytes, max_align));
+            block->prev = nullptr;
+            block->next = large_blocks;
+            block->bytes = header + bytes;
+            if (large_blocks)
+                large_blocks->prev = block;
+            large_blocks = block;
+            return reinterpret_cast<char*>(block) + header;
+        }
+
+        // refill an empty free list with a new chunk
+        if (free_lists[idx] == nullptr)
+        {
+            const size_t block_size = min_block << idx;
+            const size_t header = align_up(sizeof(chunk), max_align);
+            const size_t chunk_bytes = header + blocks_per_chunk * block_size;
+            chunk* new_chunk = static_cast<chunk*>(upstream->allocate(chunk_bytes, max_align));
+            new_chunk->next = chunks;
+            new_chunk->bytes = chunk_bytes;
+            chunks = new_chunk;
+
+            char* block = reinterpret_cast<char*>(new_chunk) + header;
+            for (size_t count = 0; count < blocks_per_chunk; ++count, block += block_size)
+            {
+                *reinterpret_cast<void**>(block) = free_lists[idx];
+                free_lists[idx] = block;
+            }
+        }
+
+        void* result = free_lists[idx];
+        free_lists[idx] = *static_cast<void**>(result);
+        return result;
+    }
+
+    void pool_resource::do_deallocate(void* p, size_t bytes, size_t)
+    {
+        const int idx = size_class(bytes, min_block, num_classes);
+
+        if (idx == num_classes)
+        {
+            const size_t header = align_up(sizeof(oversized), max_align);
+            oversized* block = reinterpret_cast<oversized*>(static_cast<char*>(p) - header);
+            if (block->prev)
+                block->prev->next = block->next;
+            else
+                large_blocks = block->next;
+            if (block->next)
+                block->next->prev = block->prev;
+            upstream->deallocate(block, block->bytes, max_align);
+            return;
+        }
+
+        *static_cast<void**>(p) = free_lists[idx];
+        free_lists[idx] = p;
+    }
+
+    void pool_resource::release()
+    {
+        for (int idx = 0; idx < num_classes; ++idx)
+            free_lists[idx] = nullptr;
+
+        while (chunks != nullptr)
+        {
+            chunk* next = chunks->next;
+            upstream->deallocate(chunks, chunks->bytes, max_align);
+            chunks = next;
+        }
+
+        while (large_blocks != nullptr)
+        {
+            oversized* next = large_blocks->next;
+            upstream->deallocate(large_blocks, large_blocks->bytes, max_align);
+            large_blocks = next;
+        }
+    }
+
+}
@@ -0,0 +1,160 @@
+#include "../exread/montgomery.hpp"
+#include "scratch.hpp"
+
+#include <algorithm> // std::copy, std::fill
+
+namespace exread {
+
+    /*
+     *  construction
+     */
+    MontgomeryContext::MontgomeryContext(const BigInt& modulus) : m(modulus), n(modulus.size())
+    {
+        if (m.is_negative() || m.size() == 0 || !m.test_bit(0))
+            throw std::invalid_argument("MontgomeryContext: modulus must be odd and positive");
+
+        // inverse of the lowest limb modulo b by Newton iteration; x*m0 == 1 mod 8 for odd m0,
+        // and every step doubles the number of correct bits
+        const mpn::limb_t m0 = m.limbs_read()[0];
+        mpn::limb_t inv = m0;
+        for (int bits = 3; bits < mpn::limb_bits; bits *= 2)
+            inv = (inv * (2 - m0 * inv)) & mpn::limb_mask;
+        m_inv = (mpn::limb_base - inv) & mpn::limb_mask;
+
+        // a normalized BigInt may have fewer than n limbs (R^2 mod 65537 == 1), but mul reads n
+        r2.resize(n);
+        to_limbs(r2.data(), (BigInt(1) << (2 * n * mpn::limb_bits)) % m);
+    }
+
+    /*
+     *  raw limb interface
+     */
+    void MontgomeryContext::redc(mpn::limb_t* rp, mpn::limb_t* tp) const
+    {
+        const mpn::limb_t* mp = m.limbs_read();
+
+        // clear the low limbs one by one by adding multiples of m
+        for (size_t idx = 0; idx < n; ++idx)
+        {
+            const mpn::limb_t u = (tp[idx] * m_inv) & mpn::limb_mask;
+            const mpn::limb_t carry = mpn::addmul_1(tp + idx, mp, n, u);
+            mpn::add_1(tp + idx + n, tp + idx + n, n + 1 - idx, carry);
+        }
+
+        // the result {tp + n, n + 1} is below 2m
+        if (tp[2*n] != 0 || mpn::cmp(tp + n, mp, n) >= 0)
+            mpn::sub_n(rp, tp + n, mp, n);
+        else
+            std::copy(tp + n, tp + 2*n, rp);
+    }
+
+    void MontgomeryContext::mul(mpn::limb_t* rp, const mpn::limb_t* ap, const mpn::limb_t* bp, mpn::limb_t* scratch) const
+    {
+        const mpn::limb_t* mp = m.limbs_read();
+        mpn::limb_t* tp = scratch;
+        std::fill(tp, tp + 2*n + 2, 0);
+
+        // interleave the multiplication by one limb of b with one reduction step;
+        // the partial result lives in {tp + idx, n + 2}, the low limbs being cleared
+        for (size_t idx = 0; idx < n; ++idx)
+        {
+            mpn::limb_t carry = mpn::addmul_1(tp + idx, ap, n, bp[idx]);
+            mpn::add_1(tp + idx + n, tp + idx + n, 2, carry);
+
+            const mpn::limb_t u = (tp[idx] * m_inv) & mpn::limb_mask;
+            carry = mpn::addmul_1(tp + idx, mp, n, u);
+            mpn::add_1(tp + idx + n, tp + idx + n, 2, carry);
+        }
+
+        // the result {tp + n, n + 1} is below 2m
+        if (tp[2*n] != 0 || mpn::cmp(tp + n, mp, n) >= 0)
+            mpn::sub_n(rp, tp + n, mp, n);
+        else
+            std::copy(tp + n, tp + 2*n, rp);
+    }
+
+    void MontgomeryContext::sqr(mpn::limb_t* rp, const mpn::limb_t* ap, mpn::limb_t* scratch) const
+    {
+        mpn::sqr_basecase(scratch, ap, n);
+        scratch[2*n] = 0;
+        redc(rp, scratch);
+    }
+
+    void MontgomeryContext::to_montgomery(mpn::limb_t* rp, const mpn::limb_t* ap, mpn::limb_t* scratch) const
+    {
+        // a * R^2 * R^-1
+        mul(rp, ap, r2.data(), scratch);
+    }
+
+    void MontgomeryContext::from_montgomery(mpn::limb_t* rp, const mpn::limb_t* ap, mpn::limb_t* scratch) const
+    {
+        // a * 1 * R^-1
+        std::copy(ap, ap + n, scratch);
+        std::fill(scratch + n, scratch + 2*n + 1, 0);
+        redc(rp, scratch);
+    }
+
+    /*
+     *  BigInt interface
+     */
+    void MontgomeryContext::to_limbs(mpn::limb_t* rp, const BigInt& a) const
+    {
+        // residues in [0, m) are copied as they are, anything else is reduced first
+        if (a.is_negative() || a >= m)
+        {
+            BigInt reduced = a % m;
+            if (reduced.is_negative())
+                reduced = reduced + m;
+            to_limbs(rp, reduced);
+            return;
+        }
+        std::copy(a.limbs_read(), a.limbs_read() + a.size(), rp);
+        std::fill(rp + a.size(), rp + n, 0);
+    }
+
+    BigInt MontgomeryContext::from_limbs(const mpn::limb_t* ap) const
+    {
+        BigInt res;
+        std::copy(ap, ap + n, res.limbs_write(n));
+        res.limbs_finish(n);
+        return res;
+    }
+
+    BigInt MontgomeryContext::to_montgomery(const BigInt& a) const
+    {
+        const scratch_buffer limbs(n);
+        const scratch_buffer scratch(scratch_size());
+        to_limbs(limbs.data(), a);
+        to_montgomery(limbs.data(), limbs.data(), scratch.data());
+        return from_limbs(limbs.data());
+    }
+
+    BigInt MontgomeryContext::from_montgomery(const BigInt& a) const
+    {
+        const scratch_buffer limbs(n);
+        const scratch_buffer scratch(scratch_size());
+        to_limbs(limbs.data(), a);
+        from_montgomery(limbs.data(), limbs.data(), scratch.data());
+        return from_limbs(limbs.data());
+    }
+
+    BigInt MontgomeryContext::mul(const BigInt& a, const BigInt& b) const
+    {
+        const scratch_buffer a_limbs(n), b_limbs(n);
+        const scratch_buffer scratch(scratch_size());
+        to_limbs(a_limbs.data(), a);
+        to_limbs(b_limbs.data(), b);
+        mul(a_limbs.data(), a_limbs.data(), b_limbs.data(), scratch.data());
+        return from_limbs(a_limbs.data());
+    }
+
+    BigInt MontgomeryContext::sqr(const BigInt& a) const
+    {
+        const scratch_buffer limbs(n);
+        const scratch_buffer scratch(scratch_size());
+        to_limbs(limbs.data(), a);
+        sqr(limbs.data(), limbs.data(), scratch.data());
+        return from_limbs(limbs.data());
+    }
+
+}
@@ -0,0 +1,291 @@
+#include "../exread/mpn.hpp"
+
+#include <algorithm> // std::copy, std::fill, std::max, std::min
+
+namespace exread {
+
+    namespace mpn {
+
+        /*
+         *  mul_basecase
+         */
+        void mul_basecase(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn)
+        {
+            assert(un >= 1 && vn >= 1);
+
+            rp[un] = mul_1(rp, up, un, vp[0]);
+            for (size_t idx = 1; idx < vn; ++idx)
+                rp[un+idx] = addmul_1(rp+idx, up, un, vp[idx]);
+        }
+
+        /*
+         *  sqr_basecase
+         */
+        void sqr_basecase(limb_t* rp, const limb_t* up, size_t n)
+        {
+            assert(n >= 1);
+
+            // off-diagonal products up[i]*up[j] with i < j, each computed once
+            rp[0] = 0;
+            rp[n] = mul_1(rp+1, up+1, n-1, up[0]);
+            for (size_t idx = 1; idx < n; ++idx)
+                rp[idx+n] = addmul_1(rp+2*idx+1, up+idx+1, n-1-idx, up[idx]);
+
+            // double them; the sum of the off-diagonal products is below b^(2n) / 2
+            lshift(rp, rp, 2*n, 1);
+
+            // add the diagonal products up[i]^2
+            limb_t carry = 0;
+            for (size_t idx = 0; idx < n; ++idx)
+            {
+                const limb_t square = up[idx] * up[idx];
+                carry += rp[2*idx] + (square & limb_mask);
+                rp[2*idx] = carry & limb_mask;
+                carry >>= limb_bits;
+                carry += rp[2*idx+1] + (square >> limb_bits);
+                rp[2*idx+1] = carry & limb_mask;
+                carry >>= limb_bits;
+            }
+            assert(carry == 0);
+        }
+
+        /*
+         *  Karatsuba multiplication
+         *
+         *  With u = u1*b^l + u0 and v = v1*b^l + v0, the product is
+         *  z2*b^2l + (z0 + z2 - (u0 - u1)*(v0 - v1))*b^l + z0 where z0 = u0*v0 and
+         *  z2 = u1*v1. The differences fit into l limbs, so no carries arise.
+         */
+        // {rp, un} = |{up, un} - {vp, vn}| with un >= vn; returns true if u < v
+        static bool abs_diff(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn)
+        {
+            if (cmp(up, normalized_size(up, un), vp, normalized_size(vp, vn)) >= 0)
+            {
+                sub(rp, up, un, vp, vn);
+                return false;
+            }
+
+            // u < v, hence the limbs of u above vn are zero
+            sub_n(rp, vp, up, vn);
+            std::fill(rp + vn, rp + un, 0);
+            return true;
+        }
+
+        // scratch limbs of mul_n and sqr_n; 4l+1 per level of recursion
+        static size_t karatsuba_scratch_size(size_t n)
+        {
+            size_t total = 0;
+            for ( ; n >= karatsuba_threshold; n = (n + 1) / 2)
+                total += 4 * ((n + 1) / 2) + 1;
+            return total;
+        }
+
+        // {rp, 2n} += {wp, 2l+1} * b^l, the middle term of the recursion
+        static void add_middle(limb_t* rp, size_t n, size_t l, const limb_t* wp)
+        {
+            const limb_t carry = add(rp + l, rp + l, 2*n - l, wp, 2*l + 1);
+            assert(carry == 0);
+            (void) carry;
+        }
+
+        // {rp, 2n} = {up, n} * {vp, n}
+        static void mul_n(limb_t* rp, const limb_t* up, const limb_t* vp, size_t n, limb_t* scratch)
+        {
+            if (n < karatsuba_threshold)
+            {
+                mul_basecase(rp, up, n, vp, n);
+                return;
+            }
+
+            const size_t l = (n + 1) / 2;
+            const size_t h = n - l;
+            limb_t* const tp = scratch; // 2l limbs
+            limb_t* const du = scratch + 2*l; // l limbs, later the middle term of 2l+1 limbs
+            limb_t* const dv = du + l; // l limbs
+            limb_t* const next = scratch + 4*l + 1;
+
+            const bool neg_u = abs_diff(du, up, l, up + l, h);
+            const bool neg_v = abs_diff(dv, vp, l, vp + l, h);
+            mul_n(tp, du, dv, l, next);
+            mul_n(rp, up, vp, l, next);
+            mul_n(rp + 2*l, up + l, vp + l, h, next);
+
+            // middle term z0 + z2 -+ |u0 - u1| * |v0 - v1|, nonnegative and below 2*b^2l
+            limb_t* const wp = du;
+            std::copy(rp, rp + 2*l, wp);
+            wp[2*l] = add(wp, wp, 2*l, rp + 2*l, 2*h);
+            if (neg_u == neg_v)
+                sub(wp, wp, 2*l + 1, tp, 2*l);
+            else
+                add(wp, wp, 2*l + 1, tp, 2*l);
+            add_middle(rp, n, l, wp);
+        }
+
+        // {rp, 2n} = {up, n}^2
+        static void sqr_n(limb_t* rp, const limb_t* up, size_t n, limb_t* scratch)
+        {
+            if (n < karatsuba_threshold)
+            {
+                sqr_basecase(rp, up, n);
+                return;
+            }
+
+            const size_t l = (n + 1) / 2;
+            const size_t h = n - l;
+            limb_t* const tp = scratch; // 2l limbs
+            limb_t* const du = scratch + 2*l; // l limbs, later the middle term of 2l+1 limbs
+            limb_t* const next = scratch + 4*l + 1;
+
+            abs_diff(du, up, l, up + l, h);
+            sqr_n(tp, du, l, next);
+            sqr_n(rp, up, l, next);
+            sqr_n(rp + 2*l, up + l, h, next);
+
+            // middle term z0 + z2 - (u0 - u1)^2
+            limb_t* const wp = du;
+            std::copy(rp, rp + 2*l, wp);
+            wp[2*l] = add(wp, wp, 2*l, rp + 2*l, 2*h);
+            sub(wp, wp, 2*l + 1, tp, 2*l);
+            add_middle(rp, n, l, wp);
+        }
+
+        size_t mul_scratch_size(size_t un, size_t vn)
+        {
+            if (vn < karatsuba_threshold)
+                return 0;
+            if (un == vn)
+                return karatsuba_scratch_size(vn);
+
+            // a chunk product of 2vn limbs, then the scratch of a full chunk or of the last, partial one
+            const size_t rest = un % vn;
+            const size_t partial = rest < karatsuba_threshold ? 0 : mul_scratch_size(vn, rest);
+            return 2*vn + std::max(karatsuba_scratch_size(vn), partial);
+        }
+
+        size_t sqr_scratch_size(size_t n)
+        {
+            return karatsuba_scratch_size(n);
+        }
+
+        /*
+         *  mul
+         */
+        void mul(limb_t* rp, const limb_t* up, size_t un, const limb_t* vp, size_t vn, limb_t* scratch)
+        {
+            assert(un >= vn && vn >= 1);
+
+            if (vn < karatsuba_threshold)
+            {
+                mul_basecase(rp, up, un, vp, vn);
+                return;
+            }
+            if (un == vn)
+            {
+                mul_n(rp, up, vp, vn, scratch);
+                return;
+            }
+
+            // multiply chunks of vn limbs of u by v and accumulate
+            limb_t* const tp = scratch; // 2vn limbs
+            limb_t* const next = scratch + 2*vn;
+            mul_n(rp, up, vp, vn, next);
+            for (size_t offset = vn; offset < un; offset += vn)
+            {
+                const size_t len = std::min(vn, un - offset);
+                if (len == vn)
+                    mul_n(tp, up + offset, vp, vn, next);
+                else
+                    mul(tp, vp, vn, up + offset, len, next);
+                const limb_t carry = add(rp + offset, tp, len + vn, rp + offset, vn);
+                assert(carry == 0);
+                (void) carry;
+            }
+        }
+
+        /*
+         *  sqr
+         */
+        void sqr(limb_t* rp, const limb_t* up, size_t n, limb_t* scratch)
+        {
+            assert(n >= 1);
+            sqr_n(rp, up, n, scratch);
+        }
+
+        /*
+         *  divrem (Knuth, TAOCP vol. 2, 4.3.1, algorithm D)
+         */
+        void divrem(limb_t* qp, limb_t* rp, const limb_t* np, size_t nn, const limb_t* dp, size_t dn, limb_t* scratch)
+        {
+            assert(nn >= dn && dn >= 1);
+            assert(dp[dn-1] != 0);
+
+            if (dn == 1)
+            {
+                rp[0] = divrem_1(qp, np, nn, dp[0]);
+                return;
+            }
+
+            // normalize such that the highest bit of the divisor is set
+            const int shift = count_leading_zeros(dp[dn-1]);
+            limb_t* const un = scratch; // nn+1 limbs
+            limb_t* const vn = scratch + nn + 1; // dn limbs
+            if (shift)
+            {
+                lshift(vn, dp, dn, shift);
+                un[nn] = lshift(un, np, nn, shift);
+            } else {
+                for (size_t idx = 0; idx < dn; ++idx)
+                    vn[idx] = dp[idx];
+                for (size_t idx = 0; idx < nn; ++idx)
+                    un[idx] = np[idx];
+                un[nn] = 0;
+            }
+
+            const limb_t v_high = vn[dn-1];
+            const limb_t v_next = vn[dn-2];
+
+            for (size_t j = nn - dn + 1; j > 0; )
+            {
+                --j;
+
+                // estimate the quotient digit from the leading two digits; un[j+dn] <= v_high, hence no overflow
+                const limb_t num = (un[j+dn] << limb_bits) | un[j+dn-1];
+                limb_t q_hat = num / v_high;
+                limb_t r_hat = num % v_high;
+                if (q_hat > limb_mask)
+                {
+                    r_hat += (q_hat - limb_mask) * v_high;
+                    q_hat = limb_mask;
+                }
+                while (r_hat <= limb_mask && q_hat * v_next > ((r_hat << limb_bits) | un[j+dn-2]))
+                {
+                    --q_hat;
+                    r_hat += v_high;
+                }
+
+                // multiply and subtract; q_hat is at most one too large now
+                const limb_t borrow = submul_1(un+j, vn, dn, q_hat);
+                if (un[j+dn] < borrow)
+                {
+                    --q_hat;
+                    const limb_t carry = add_n(un+j, un+j, vn, dn);
+                    un[j+dn] = (un[j+dn] + carry - borrow) & limb_mask;
+                } else {
+                    un[j+dn] -= borrow;
+                }
+                assert(un[j+dn] == 0);
+
+                qp[j] = q_hat;
+            }
+
+            // denormalize the remainder
+            if (shift)
+                rshift(rp, un, dn, shift);
+            else
+                for (size_t idx = 0; idx < dn; ++idx)
+                    rp[idx] = un[idx];
+        }
+
+    }
+
+}
@@ -0,0 +1,199 @@
+#include "../exread/numtheory.hpp"
+#include "scratch.hpp"
+
+#include <algorithm> // std::copy, std::fill, std::min
+#include <vector> // std::vector
+
+namespace exread {
+
+    /*
+     *  sliding window exponentiation
+     */
+    // window size for an exponent of 'bits' bits, balancing the 2^(k-1) precomputed
+    // odd powers against the multiplications saved in the main loop
+    static size_t window_size(size_t bits)
+    {
+        if (bits <= 24)
+            return 1;
+        if (bits <= 80)
+            return 3;
+        if (bits <= 240)
+            return 4;
+        if (bits <= 672)
+            return 5;
+        if (bits <= 1792)
+            return 6;
+        return 7;
+    }
+
+    // scan the positive 'exponent' from the top with windows of at most 'k' bits ending
+    // in a set bit; 'domain' provides
+    //   precompute(): fill the table with base^1, base^3, ..., base^(2^k - 1)
+    //   set(idx):     acc = table[idx]
+    //   sqr():        acc = acc^2
+    //   mul(idx):     acc = acc * table[idx]
+    template<typename Domain>
+    static void sliding_window(Domain& domain, const BigInt& exponent, size_t k)
+    {
+        assert(!exponent.is_negative() && exponent != 0);
+
+        size_t pos = exponent.bit_length();
+        domain.precompute();
+
+        bool first = true;
+        while (pos > 0)
+        {
+            if (!exponent.test_bit(pos-1))
+            {
+                domain.sqr();
+                --pos;
+                continue;
+            }
+
+            // longest window [pos-len, pos) with len <= k whose lowest bit is set
+            size_t len = std::min(k, pos);
+            while (!exponent.test_bit(pos-len))
+                --len;
+            size_t window = 0;
+            for (size_t idx = pos; idx > pos-len; --idx)
+                window = 2*window + exponent.test_bit(idx-1);
+
+            if (first)
+            {
+                domain.set(window / 2);
+                first = false;
+            } else {
+                for (size_t idx = 0; idx < len; ++idx)
+                    domain.sqr();
+                domain.mul(window / 2);
+            }
+            pos -= len;
+        }
+    }
+
+    // Montgomery forms as raw limbs
+    class montgomery_domain
+    {
+        private:
+
+            const MontgomeryContext& ctx;
+            const size_t n;
+            const size_t entries;
+            mpn::limb_t* table; // entries * n limbs, starting with the Montgomery form of the base
+            mpn::limb_t* acc; // n limbs
+            mpn::limb_t* scratch; // ctx.scratch_size() limbs
+
+        public:
+
+            montgomery_domain(const MontgomeryContext& ctx, size_t entries, mpn::limb_t* table, mpn::limb_t* acc, mpn::limb_t* scratch) :
+                ctx(ctx), n(ctx.size()), entries(entries), table(table), acc(acc), scratch(scratch) {};
+
+            void precompute()
+            {
+                if (entries == 1)
+                    return;
+                ctx.sqr(acc, table, scratch); // base^2
+                for (size_t idx = 1; idx < entries; ++idx)
+                    ctx.mul(table + idx*n, table + (idx-1)*n, acc, scratch);
+            };
+
+            void set(size_t idx) { std::copy(table + idx*n, table + (idx+1)*n, acc); };
+            void sqr() { ctx.sqr(acc, acc, scratch); };
+            void mul(size_t idx) { ctx.mul(acc, acc, table + idx*n, scratch); };
+    };
+
+    // residues as BigInt, reduced by Barrett reduction
+    class barrett_domain
+    {
+        private:
+
+            const BarrettContext& ctx;
+            const size_t entries;
+            std::vector<BigInt> table;
+
+        public:
+
+            BigInt acc;
+
+            barrett_domain(const BarrettContext& ctx, size_t entries, const BigInt& base) : ctx(ctx), entries(entries), table(1, base), acc() {};
+
+            void precompute()
+            {
+                if (entries == 1)
+                    return;
+                const BigInt square = ctx.sqr(table[0]);
+                for (size_t idx = 1; idx < entries; ++idx)
+                    table.push_back(ctx.mul(table[idx-1], square));
+            };
+
+            void set(size_t idx) { acc = table[idx]; };
+            void sqr() { acc = ctx.sqr(acc); };
+            void mul(size_t idx) { acc = ctx.mul(acc, table[idx]); };
+    };
+
+    // a mod m in [0, m) for m > 0
+    static BigInt nonnegative_mod(const BigInt& a, const BigInt& m)
+    {
+        BigInt res = a % m;
+        if (res.is_negative())
+            res = res + m;
+        return res;
+    }
+
+    /*
+     *  powmod
+     */
+    BigInt powmod(const BigInt& base, const BigInt& exponent, const MontgomeryContext& ctx)
+    {
+        const BigInt& m = ctx.modulus();
+        if (exponent.is_negative())
+            return powmod(invert(base, m), -exponent, ctx);
+        if (exponent == 0)
+            return nonnegative_mod(1, m);
+
+        const size_t n = ctx.size();
+        const size_t k = window_size(exponent.bit_length());
+        const size_t entries = size_t(1) << (k-1);
+        const scratch_buffer table(entries * n);
+        const scratch_buffer acc(n);
+        const scratch_buffer scratch(ctx.scratch_size());
+
+        const BigInt base_form = ctx.to_montgomery(base);
+        std::copy(base_form.limbs_read(), base_form.limbs_read() + base_form.size(), table.data());
+        std::fill(table.data() + base_form.size(), table.data() + n, 0);
+
+        montgomery_domain domain(ctx, entries, table.data(), acc.data(), scratch.data());
+        sliding_window(domain, exponent, k);
+
+        BigInt res(base.resource());
+        ctx.from_montgomery(res.limbs_write(n), acc.data(), scratch.data());
+        res.limbs_finish(n);
+        return res;
+    }
+
+    BigInt powmod(const BigInt& base, const BigInt& exponent, const BarrettContext& ctx)
+    {
+        const BigInt& m = ctx.modulus();
+        if (exponent.is_negative())
+            return powmod(invert(base, m), -exponent, ctx);
+        if (exponent == 0)
+            return nonnegative_mod(1, m);
+
+        const size_t k = window_size(exponent.bit_length());
+        barrett_domain domain(ctx, size_t(1) << (k-1), ctx.reduce(base));
+        sliding_window(domain, exponent, k);
+        return domain.acc;
+    }
+
+    BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus)
+    {
+        if (modulus == 0)
+            throw std::invalid_argument("powmod: modulus must be nonzero");
+
+        const BigInt m = modulus.is_negative() ? -modulus : modulus;
+        if (m.test_bit(0))
+            return powmod(base, exponent, MontgomeryContext(m));
+        return powmod(base, exponent, BarrettContext(m));
+    }
+
+}
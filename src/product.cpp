@@ -0,0 +1,82 @@
+#include "../exread/product.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm> // std::all_of, std::lower_bound, std::max, std::min
+
+namespace exread {
+
+    // subtrees of at least this many limbs in total are split across threads
+    static constexpr size_t product_parallel_limbs = 4096;
+
+    // resources that may be used from several threads at once
+    static bool is_thread_safe(memory_resource* resource)
+    {
+        return resource == memory_functions_resource() || resource == new_delete_resource();
+    }
+
+    /*
+     *  balanced product tree
+     */
+    namespace {
+
+        class product_tree
+        {
+            private:
+
+                const BigInt* const* factors;
+                std::vector<size_t> prefix_limbs; // prefix_limbs[idx] = total size of factors[0, idx)
+                bool parallel;
+
+            public:
+
+                product_tree(const BigInt* const* factors, size_t count) : factors(factors), prefix_limbs(count + 1, 0), parallel()
+                {
+                    for (size_t idx = 0; idx < count; ++idx)
+                        prefix_limbs[idx+1] = prefix_limbs[idx] + factors[idx]->size();
+                    parallel = prefix_limbs[count] >= product_parallel_limbs &&
+                               std::all_of(factors, factors + count, [](const BigInt* factor) { return is_thread_safe(factor->resource()); });
+                };
+
+                // product of factors[first, last) with last - first >= 1
+                BigInt multiply(size_t first, size_t last) const
+                {
+                    if (last - first == 1)
+                        return BigInt(*factors[first], factors[first]->resource());
+                    if (last - first == 2)
+                        return *factors[first] * *factors[first+1];
+
+                    // split where half of the limbs are on either side
+                    const size_t middle_limbs = (prefix_limbs[first] + prefix_limbs[last]) / 2;
+                    size_t split = std::lower_bound(prefix_limbs.begin() + first, prefix_limbs.begin() + last, middle_limbs) - prefix_limbs.begin();
+                    split = std::min(std::max(split, first + 1), last - 1);
+
+                    if (parallel && prefix_limbs[last] - prefix_limbs[first] >= product_parallel_limbs)
+                    {
+                        BigInt left(factors[first]->resource());
+                        thread_pool::task task([this, &left, first, split]() { left = multiply(first, split); });
+                        thread_pool::shared().submit(task);
+                        BigInt right(factors[split]->resource());
+                        try {
+                            right = multiply(split, last);
+                        } catch (...) {
+                            // 'task' refers to this frame and must finish before leaving it
+                            try { thread_pool::shared().wait(task); } catch (...) {}
+                            throw;
+                        }
+                        thread_pool::shared().wait(task);
+                        return left * right;
+                    }
+                    return multiply(first, split) * multiply(split, last);
+                };
+        };
+
+    }
+
+    BigInt product_detail::product(const BigInt* const* factors, size_t count)
+    {
+        if (count == 0)
+            return 1;
+        return product_tree(factors, count).multiply(0, count);
+    }
+
+}
@@ -0,0 +1,147 @@
+#include "../exread/rational.hpp"
+#include "../exread/numtheory.hpp"
+
+#include <utility> // std::move
+
+namespace exread {
+
+    /*
+     *  constructors and reduction
+     */
+    Rational::Rational(BigInt num, BigInt den, bool reduced, bool lazy) : num(std::move(num)), den(std::move(den)), reduced(reduced), lazy(lazy)
+    {
+        assert(!this->den.is_negative() && this->den != 0);
+    }
+
+    Rational::Rational(const BigInt& num, const BigInt& den) : num(num), den(den), reduced(false), lazy(false)
+    {
+        if (den == 0)
+            throw std::invalid_argument("Rational: zero denominator");
+        if (den.is_negative())
+        {
+            this->num = -this->num;
+            this->den = -this->den;
+        }
+        reduce();
+    }
+
+    void Rational::reduce() const
+    {
+        if (reduced)
+            return;
+
+        if (num == 0)
+        {
+            den = BigInt(1, den.resource());
+        } else {
+            const BigInt g = gcd(num, den);
+            if (g != 1)
+            {
+                num = num / g;
+                den = den / g;
+            }
+        }
+        reduced = true;
+    }
+
+    Rational& Rational::set_lazy(bool on)
+    {
+        lazy = on;
+        if (!lazy)
+            reduce();
+        return *this;
+    }
+
+    /*
+     *  comparison
+     */
+    int Rational::compare(const Rational& other) const
+    {
+        // the sign decides unless both have the same
+        const int sign = num.is_negative() ? -1 : num == 0 ? 0 : 1;
+        const int other_sign = other.num.is_negative() ? -1 : other.num == 0 ? 0 : 1;
+        if (sign != other_sign)
+            return sign < other_sign ? -1 : 1;
+
+        if (den == other.den)
+            return num.compare(other.num);
+        return (num * other.den).compare(other.num * den);
+    }
+
+    /*
+     *  arithmetic
+     */
+    Rational operator+ (const Rational& r1, const Rational& r2)
+    {
+        const BigInt& a = r1.num;
+        const BigInt& b = r1.den;
+        const BigInt& c = r2.num;
+        const BigInt& d = r2.den;
+
+        if (r1.lazy || r2.lazy)
+        {
+            if (b == d)
+                return {a + c, b, false, true};
+            return {a * d + c * b, b * d, false, true};
+        }
+
+        // a/b + c/d for reduced operands: with g = gcd(b, d), any common factor of the
+        // numerator t = a*(d/g) + c*(b/g) and the denominator b*d/g divides g
+        if (b == 1 && d == 1)
+            return a + c;
+        const BigInt g = gcd(b, d);
+        if (g == 1)
+            return {a * d + c * b, b * d, true, false};
+
+        const BigInt b_g = b / g;
+        const BigInt t = a * (d / g) + c * b_g;
+        if (t == 0)
+            return Rational(BigInt(r1.num.resource()));
+        const BigInt g2 = gcd(t, g);
+        if (g2 == 1)
+            return {t, b_g * d, true, false};
+        return {t / g2, b_g * (d / g2), true, false};
+    }
+
+    Rational operator- (const Rational& r1, const Rational& r2)
+    {
+        return r1 + (-r2);
+    }
+
+    Rational operator* (const Rational& r1, const Rational& r2)
+    {
+        const BigInt& a = r1.num;
+        const BigInt& b = r1.den;
+        const BigInt& c = r2.num;
+        const BigInt& d = r2.den;
+
+        if (r1.lazy || r2.lazy)
+            return {a * c, b * d, false, true};
+
+        // (a/b) * (c/d) for reduced operands: only a and d, or c and b can share factors
+        if (a == 0 || c == 0)
+            return Rational(BigInt(a.resource()));
+        const BigInt g1 = gcd(a, d);
+        const BigInt g2 = gcd(c, b);
+        if (g1 == 1 && g2 == 1)
+            return {a * c, b * d, true, false};
+        return {(a / g1) * (c / g2), (b / g2) * (d / g1), true, false};
+    }
+
+    Rational operator/ (const Rational& r1, const Rational& r2)
+    {
+        if (r2.num == 0)
+            throw std::invalid_argument("Division by Rational(0)");
+        return r1 * r2.inverse();
+    }
+
+    Rational Rational::inverse() const
+    {
+        if (num == 0)
+            throw std::invalid_argument("Division by Rational(0)");
+        if (num.is_negative())
+            return {-den, -num, reduced, lazy};
+        return {den, num, reduced, lazy};
+    }
+
+}
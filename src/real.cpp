@@ -0,0 +1,317 @@
+#include "../exread/real.hpp"
+#include "../exread/numtheory.hpp"
+
+#include <algorithm> // std::max, std::min
+
+namespace exread {
+
+    namespace real_detail {
+
+        // round(a * 2^count)
+        static BigInt scaled(const BigInt& a, long count)
+        {
+            if (count >= 0)
+                return a << size_t(count);
+            // operator>> rounds towards negative infinity
+            return ((a >> size_t(-count - 1)) + 1) >> 1;
+        }
+
+        // round(n / d) for d > 0
+        static BigInt rounded_quotient(const BigInt& n, const BigInt& d)
+        {
+            const BigInt q = ((n.is_negative() ? -n : n) * 2 + d) / (d * 2);
+            return n.is_negative() ? -q : q;
+        }
+
+        /*
+         *  cache
+         */
+        BigInt node::approximate(long p) const
+        {
+            if (valid && p >= cached_p)
+                return scaled(cached, cached_p - p);
+
+            // refine by at least half of the cached bits, such that a sequence of slightly
+            // finer requests does not recompute the whole expression each time
+            const long q = valid ? std::min(p, cached_p - long(cached.bit_length() / 2) - 16) : p;
+
+            cached = compute(q);
+            cached_p = q;
+            valid = true;
+            return scaled(cached, q - p);
+        }
+
+        long node::msd(long limit) const
+        {
+            // |a - x * 2^-p| < 1 and |a| >= 2 imply 2^(p+bits-2) < |x| < 2^(p+bits),
+            // |a| <= 1 implies |x| < 2^(p+1)
+            long p = limit != no_msd && limit > 1 ? limit - 1 : 0;
+            while (true)
+            {
+                const size_t bits = approximate(p).bit_length();
+                if (bits >= 2)
+                    return p + long(bits);
+                if (limit != no_msd && p <= limit - 1)
+                    return no_msd;
+
+                p = 2*p - 16;
+                if (limit != no_msd)
+                    p = std::max(p, limit - 1);
+            }
+        }
+
+        /*
+         *  nodes
+         */
+        class rational_node : public node
+        {
+            private:
+
+                const Rational r;
+
+                BigInt compute(long p) const override
+                {
+                    const BigInt& n = r.numerator();
+                    const BigInt& d = r.denominator();
+                    if (d == 1)
+                        return scaled(n, -p);
+                    if (p <= 0)
+                        return rounded_quotient(n << size_t(-p), d);
+                    return rounded_quotient(n, d << size_t(p));
+                }
+
+            public:
+
+                explicit rational_node(const Rational& r) : r(r) {};
+
+        };
+
+        class negate_node : public node
+        {
+            private:
+
+                const std::shared_ptr<const node> x;
+
+                BigInt compute(long p) const override
+                {
+                    return -x->approximate(p);
+                }
+
+            public:
+
+                explicit negate_node(std::shared_ptr<const node> x) : x(std::move(x)) {};
+
+        };
+
+        class shift_node : public node
+        {
+            private:
+
+                const std::shared_ptr<const node> x;
+                const long count;
+
+                BigInt compute(long p) const override
+                {
+                    return x->approximate(p - count);
+                }
+
+            public:
+
+                shift_node(std::shared_ptr<const node> x, long count) : x(std::move(x)), count(count) {};
+
+        };
+
+        class add_node : public node
+        {
+            private:
+
+                const std::shared_ptr<const node> x;
+                const std::shared_ptr<const node> y;
+
+                BigInt compute(long p) const override
+                {
+                    // two errors below 1/4 each and the final rounding by at most 1/2
+                    return scaled(x->approximate(p - 2) + y->approximate(p - 2), -2);
+                }
+
+            public:
+
+                add_node(std::shared_ptr<const node> x, std::shared_ptr<const node> y) : x(std::move(x)), y(std::move(y)) {};
+
+        };
+
+        class mul_node : public node
+        {
+            private:
+
+                const std::shared_ptr<const node> x;
+                const std::shared_ptr<const node> y;
+
+                BigInt compute(long p) const override
+                {
+                    // bounds |x| < 2^mx and |y| < 2^my; the product is negligible if
+                    // mx + my <= p, so each factor is examined only as far as necessary
+                    const long half = p / 2 - 1;
+                    long mx = x->msd(half);
+                    long my = 0;
+                    if (mx == no_msd)
+                    {
+                        my = y->msd(half);
+                        if (my == no_msd)
+                            return 0;
+                        mx = x->msd(p - my);
+                    } else {
+                        my = y->msd(p - mx);
+                    }
+                    if (mx == no_msd || my == no_msd || mx + my <= p)
+                        return 0;
+
+                    // with X, Y the approximations of x, y, |XY - xy| <= |X - x| |Y| + |x| |Y - y|
+                    // < 2^(p-3) + 2^(px+py) + 2^(p-3) < 2^(p-1)
+                    const long px = p - my - 3;
+                    const long py = p - mx - 3;
+                    return scaled(x->approximate(px) * y->approximate(py), px + py - p);
+                }
+
+            public:
+
+                mul_node(std::shared_ptr<const node> x, std::shared_ptr<const node> y) : x(std::move(x)), y(std::move(y)) {};
+
+        };
+
+        class inverse_node : public node
+        {
+            private:
+
+                const std::shared_ptr<const node> x;
+
+                BigInt compute(long p) const override
+                {
+                    // 2^(m-2) < |x| < 2^m, so |1/x| < 2^(2-m)
+                    const long m = x->msd();
+                    if (p >= 2 - m)
+                        return 0;
+
+                    // with X the approximation of x to q <= m - 5 bits, |X| > 2^(m-3) and
+                    // |1/X - 1/x| < 2^q / (2^(m-2) 2^(m-3)) = 2^(p-1)
+                    const long q = p + 2*m - 6;
+                    const BigInt a = x->approximate(q);
+                    const BigInt magnitude = a.is_negative() ? -a : a;
+                    const BigInt r = rounded_quotient(BigInt(1) << size_t(-p - q), magnitude);
+                    return a.is_negative() ? -r : r;
+                }
+
+            public:
+
+                explicit inverse_node(std::shared_ptr<const node> x) : x(std::move(x)) {};
+
+        };
+
+        class sqrt_node : public node
+        {
+            private:
+
+                const std::shared_ptr<const node> x;
+
+                BigInt compute(long p) const override
+                {
+                    // with t = x * 2^-2p, |a - 16t| < 1 gives |sqrt(a) - 4 sqrt(t)| < 1, and
+                    // isqrt(a) is less than one below sqrt(a)
+                    BigInt a = x->approximate(2*p - 4);
+                    if (a.is_negative())
+                    {
+                        if (a.bit_length() >= 2)
+                            throw std::invalid_argument("sqrt: negative argument");
+                        a = 0;
+                    }
+                    return scaled(isqrt(a), -2);
+                }
+
+            public:
+
+                explicit sqrt_node(std::shared_ptr<const node> x) : x(std::move(x)) {};
+
+        };
+
+    }
+
+    using namespace real_detail;
+
+    /*
+     *  constructors
+     */
+    Real::Real(const Rational& r) : root(std::make_shared<rational_node>(r)) {}
+
+    Real::Real(const BigFloat& f) : root(std::make_shared<rational_node>(Rational(f.mantissa())))
+    {
+        if (f.exponent() != 0)
+            root = std::make_shared<shift_node>(root, f.exponent());
+    }
+
+    /*
+     *  approximation and comparison
+     */
+    BigFloat Real::to_bigfloat(long p) const
+    {
+        const BigInt a = approximate(p);
+        return ldexp(BigFloat(a, std::max(a.bit_length(), size_t(1))), p);
+    }
+
+    int Real::compare(const Real& other, long p) const
+    {
+        // |a| >= 2 fixes the sign of the difference d, and |d| >= 2^p implies |a| >= 2
+        const BigInt a = (*this - other).approximate(p - 1);
+        if (a.bit_length() < 2)
+            return 0;
+        return a.is_negative() ? -1 : 1;
+    }
+
+    /*
+     *  arithmetic
+     */
+    Real Real::operator-() const
+    {
+        return Real(std::make_shared<negate_node>(root));
+    }
+
+    Real operator+ (const Real& x, const Real& y)
+    {
+        return Real(std::make_shared<add_node>(x.root, y.root));
+    }
+
+    Real operator- (const Real& x, const Real& y)
+    {
+        return x + (-y);
+    }
+
+    Real operator* (const Real& x, const Real& y)
+    {
+        return Real(std::make_shared<mul_node>(x.root, y.root));
+    }
+
+    Real operator/ (const Real& x, const Real& y)
+    {
+        return x * y.inverse();
+    }
+
+    Real operator<< (const Real& x, long count)
+    {
+        return Real(std::make_shared<shift_node>(x.root, count));
+    }
+
+    Real operator>> (const Real& x, long count)
+    {
+        return x << -count;
+    }
+
+    Real Real::inverse() const
+    {
+        return Real(std::make_shared<inverse_node>(root));
+    }
+
+    Real sqrt(const Real& x)
+    {
+        return Real(std::make_shared<sqrt_node>(x.root));
+    }
+
+}
@@ -0,0 +1,175 @@
+#include "../exread/numtheory.hpp"
+
+#include <cmath> // std::pow, std::sqrt
+#include <utility> // std::move
+
+namespace exread {
+
+    using ulonglong = unsigned long long;
+
+    // numbers of at most this many bits are converted exactly to double for a first estimate
+    static constexpr size_t root_double_bits = std::numeric_limits<double>::digits - 1;
+
+    static ulonglong to_ulonglong(const BigInt& n)
+    {
+        assert(!n.is_negative() && n.bit_length() <= size_t(std::numeric_limits<ulonglong>::digits));
+
+        ulonglong res = 0;
+        for (size_t idx = n.size(); idx > 0; --idx)
+            res = (res << mpn::limb_bits) | n.limbs_read()[idx-1];
+        return res;
+    }
+
+    /*
+     *  square root
+     *
+     *  The root of the leading half of the bits, shifted back, is within about
+     *  one unit in its last place; a single Newton step from there doubles the
+     *  number of correct bits, leaving an error of at most one or two, which
+     *  the remainder reveals and corrects.
+     */
+    static SqrtRemResult sqrtrem_nonnegative(const BigInt& n)
+    {
+        const size_t bits = n.bit_length();
+
+        BigInt root;
+        if (bits <= root_double_bits)
+        {
+            const ulonglong m = to_ulonglong(n);
+            ulonglong r = ulonglong(std::sqrt(double(m)));
+            while (r * r > m)
+                --r;
+            while ((r + 1) * (r + 1) <= m)
+                ++r;
+            root = BigInt(r, n.resource());
+        } else {
+            const size_t half = bits / 4;
+            const BigInt x = sqrtrem_nonnegative(n >> (2 * half)).root << half;
+            root = (x + n / x) >> 1;
+        }
+
+        BigInt rem = n - root * root;
+        while (rem.is_negative())
+        {
+            rem = rem + root + root - 1;
+            root = root - 1;
+        }
+        while (rem > root + root)
+        {
+            rem = rem - root - root - 1;
+            root = root + 1;
+        }
+        return {std::move(root), std::move(rem)};
+    }
+
+    SqrtRemResult sqrtrem(const BigInt& n)
+    {
+        if (n.is_negative())
+            throw std::invalid_argument("sqrtrem: negative argument");
+        return sqrtrem_nonnegative(n);
+    }
+
+    BigInt isqrt(const BigInt& n)
+    {
+        if (n.is_negative())
+            throw std::invalid_argument("isqrt: negative argument");
+        return sqrtrem_nonnegative(n).root;
+    }
+
+    /*
+     *  k-th root
+     *
+     *  Newton's iteration x = ((k-1)*x + n / x^(k-1)) / k decreases monotonically
+     *  towards the floor of the root when started above it. The start is the
+     *  root of the leading bits plus one, shifted back, such that only a few
+     *  steps are needed.
+     */
+    static BigInt iroot_nonnegative(const BigInt& n, unsigned k)
+    {
+        const size_t bits = n.bit_length();
+        if (k == 1 || n == 0)
+            return n;
+        if (bits <= k)
+            return BigInt(1, n.resource()); // 1 <= n < 2^k
+
+        BigInt x;
+        const size_t shift = bits / k / 2;
+        if (bits <= root_double_bits)
+        {
+            x = BigInt(ulonglong(std::pow(double(to_ulonglong(n)), 1.0 / k)), n.resource());
+            while (pow(x, k) <= n)
+                x = x + 1;
+        } else if (shift == 0) {
+            x = BigInt(1, n.resource()) << ((bits + k - 1) / k);
+        } else {
+            x = (iroot_nonnegative(n >> (k * shift), k) + 1) << shift;
+        }
+
+        const BigInt k_big = k;
+        const BigInt k_minus_one = k - 1;
+        for (;;)
+        {
+            const BigInt y = (k_minus_one * x + n / pow(x, k - 1)) / k_big;
+            if (y >= x)
+                return x;
+            x = y;
+        }
+    }
+
+    BigInt iroot(const BigInt& n, unsigned k)
+    {
+        if (k == 0)
+            throw std::invalid_argument("iroot: k must be positive");
+        if (n.is_negative())
+        {
+            if (k % 2 == 0)
+                throw std::invalid_argument("iroot: even root of a negative argument");
+            return -iroot_nonnegative(-n, k);
+        }
+        return iroot_nonnegative(n, k);
+    }
+
+    /*
+     *  perfect squares
+     */
+    namespace {
+
+        // flags of the squares modulo 'm'
+        template<unsigned m>
+        struct square_residues
+        {
+            bool flags[m];
+
+            square_residues() : flags()
+            {
+                for (unsigned x = 0; x < m; ++x)
+                    flags[x * x % m] = true;
+            }
+        };
+
+    }
+
+    bool is_perfect_square(const BigInt& n)
+    {
+        if (n.is_negative())
+            return false;
+        if (n == 0)
+            return true;
+
+        // only 44 of 256 residues modulo 256 are squares; together with the residues
+        // modulo 63, 65 and 11, over 99% of non-squares are rejected without a root
+        static const square_residues<256> mod_256;
+        static const square_residues<63> mod_63;
+        static const square_residues<65> mod_65;
+        static const square_residues<11> mod_11;
+
+        if (!mod_256.flags[n.limbs_read()[0] & 0xFF])
+            return false;
+        const mpn::limb_t r = mpn::mod_1(n.limbs_read(), n.size(), 63 * 65 * 11);
+        if (!mod_63.flags[r % 63] || !mod_65.flags[r % 65] || !mod_11.flags[r % 11])
+            return false;
+
+        return sqrtrem_nonnegative(n).rem == 0;
+    }
+
+}
@@ -0,0 +1,93 @@
+#include "scratch.hpp"
+#include "../exread/memory.hpp"
+
+#include <new> // std::bad_alloc
+#include <vector> // std::vector
+
+namespace exread {
+
+    namespace {
+
+        // size class 'c' holds buffers of 2^c limbs
+        constexpr int num_classes = std::numeric_limits<size_t>::digits;
+        // buffers kept per class; surplus buffers are freed
+        constexpr size_t max_cached = 8;
+
+        struct scratch_stack
+        {
+            std::vector<mpn::limb_t*> free_buffers[num_classes];
+
+            ~scratch_stack()
+            {
+                free_function free;
+                get_memory_functions(nullptr, nullptr, &free);
+                for (int c = 0; c < num_classes; ++c)
+                    for (mpn::limb_t* buffer : free_buffers[c])
+                        free(buffer, sizeof(mpn::limb_t) << c);
+            }
+        };
+
+        scratch_stack& thread_stack()
+        {
+            static thread_local scratch_stack stack;
+            return stack;
+        }
+
+        int class_of(size_t n)
+        {
+            int c = 0;
+            while ((size_t(1) << c) < n)
+                ++c;
+            return c;
+        }
+
+    }
+
+    scratch_buffer::scratch_buffer(size_t n) : size_class(class_of(n))
+    {
+        scratch_stack& stack = thread_stack();
+        std::vector<mpn::limb_t*>& buffers = stack.free_buffers[size_class];
+        if (!buffers.empty())
+        {
+            ptr = buffers.back();
+            buffers.pop_back();
+            return;
+        }
+
+        const size_t bytes = sizeof(mpn::limb_t) << size_class;
+
+        allocate_function allocate;
+        free_function free;
+        get_memory_functions(&allocate, nullptr, &free);
+
+        // replace the largest cached smaller buffer, if any; its contents are not needed,
+        // so it is freed instead of reallocated, which would copy them
+        for (int c = size_class; c > 0; )
+        {
+            std::vector<mpn::limb_t*>& smaller = stack.free_buffers[--c];
+            if (!smaller.empty())
+            {
+                free(smaller.back(), sizeof(mpn::limb_t) << c);
+                smaller.pop_back();
+                break;
+            }
+        }
+
+        ptr = static_cast<mpn::limb_t*>(allocate(bytes));
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+    }
+
+    scratch_buffer::~scratch_buffer()
+    {
+        std::vector<mpn::limb_t*>& buffers = thread_stack().free_buffers[size_class];
+        if (buffers.size() < max_cached)
+            buffers.push_back(ptr);
+        else {
+            free_function free;
+            get_memory_functions(nullptr, nullptr, &free);
+            free(ptr, sizeof(mpn::limb_t) << size_class);
+        }
+    }
+
+}
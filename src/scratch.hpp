@@ -0,0 +1,39 @@
+#ifndef EXREAD_SCRATCH_HPP
+#define EXREAD_SCRATCH_HPP
+
+#include "../exread/mpn.hpp"
+
+namespace exread {
+
+    /*
+     *  Per-thread cache of scratch limb buffers for temporaries of the
+     *  arithmetic kernels (internal).
+     *
+     *  Buffers are grouped in power-of-two size classes; a released buffer is
+     *  kept on a per-thread stack of its class and handed out again by the
+     *  next request of that class, such that steady-state arithmetic does not
+     *  allocate temporaries.
+     */
+    class scratch_buffer
+    {
+        private:
+
+            mpn::limb_t* ptr;
+            int size_class;
+
+        public:
+
+            // at least 'n' limbs of uninitialized scratch space
+            explicit scratch_buffer(size_t n);
+            ~scratch_buffer();
+
+            scratch_buffer(const scratch_buffer&) = delete;
+            scratch_buffer& operator= (const scratch_buffer&) = delete;
+
+            mpn::limb_t* data() const { return ptr; }
+
+    };
+
+}
+
+#endif
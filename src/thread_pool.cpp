@@ -0,0 +1,83 @@
+#include "thread_pool.hpp"
+
+#include <algorithm> // std::max
+
+namespace exread {
+
+    thread_pool::thread_pool(size_t threads) : mutex(), changed(), queue(), workers(), stopping(false)
+    {
+        for (size_t idx = 0; idx < threads; ++idx)
+            workers.emplace_back([this]() {
+                std::unique_lock<std::mutex> lock(mutex);
+                for (;;)
+                {
+                    changed.wait(lock, [this]() { return stopping || !queue.empty(); });
+                    if (queue.empty())
+                        return; // stopping
+                    task* t = queue.front();
+                    queue.pop_front();
+                    execute(t, lock);
+                }
+            });
+    }
+
+    thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    void thread_pool::execute(task* t, std::unique_lock<std::mutex>& lock)
+    {
+        lock.unlock();
+        try {
+            t->work();
+        } catch (...) {
+            t->error = std::current_exception();
+        }
+        lock.lock();
+        t->done = true;
+        changed.notify_all();
+    }
+
+    thread_pool& thread_pool::shared()
+    {
+        static thread_pool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return pool;
+    }
+
+    void thread_pool::submit(task& t)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(&t);
+        }
+        changed.notify_one();
+    }
+
+    void thread_pool::wait(task& t)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!t.done)
+        {
+            if (queue.empty())
+            {
+                changed.wait(lock);
+                continue;
+            }
+
+            // the most recently queued task first, which is 't' itself unless a worker took it
+            task* next = queue.back();
+            queue.pop_back();
+            execute(next, lock);
+        }
+        if (t.error)
+            std::rethrow_exception(t.error);
+    }
+
+}
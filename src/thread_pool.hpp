@@ -0,0 +1,79 @@
+#ifndef EXREAD_THREAD_POOL_HPP
+#define EXREAD_THREAD_POOL_HPP
+
+#include <condition_variable> // std::condition_variable
+#include <cstddef> // std::size_t
+#include <deque> // std::deque
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <mutex> // std::mutex, std::unique_lock
+#include <thread> // std::thread
+#include <utility> // std::move
+#include <vector> // std::vector
+
+namespace exread {
+
+    using std::size_t;
+
+    /*
+     *  Process-wide pool of worker threads for fork-join parallelism of the
+     *  arithmetic (internal).
+     *
+     *  A thread waiting for a task runs queued tasks itself until the task is
+     *  done, such that tasks may submit and wait for further tasks without
+     *  exhausting the workers.
+     */
+    class thread_pool
+    {
+        public:
+
+            class task
+            {
+                private:
+
+                    friend class thread_pool;
+
+                    std::function<void()> work;
+                    bool done;
+                    std::exception_ptr error;
+
+                public:
+
+                    explicit task(std::function<void()> work) : work(std::move(work)), done(false), error() {};
+
+            };
+
+        private:
+
+            std::mutex mutex;
+            std::condition_variable changed; // a task was queued or finished
+            std::deque<task*> queue;
+            std::vector<std::thread> workers;
+            bool stopping;
+
+            explicit thread_pool(size_t threads);
+            ~thread_pool();
+
+            // run 't' with 'lock' released and mark it done
+            void execute(task* t, std::unique_lock<std::mutex>& lock);
+
+        public:
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator= (const thread_pool&) = delete;
+
+            // the shared pool; at least one worker, one less than the hardware threads otherwise
+            static thread_pool& shared();
+
+            // queue 't', which must stay alive until wait(t) returns
+            void submit(task& t);
+
+            // block until 't' is done, running queued tasks meanwhile; rethrows an
+            // exception escaping from the task
+            void wait(task& t);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include "catch.hpp"
+#include "../exread/accumulator.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace exread;
+
+// 'count' summands of varying sizes and signs
+static std::vector<BigInt> make_summands(size_t count)
+{
+    std::vector<BigInt> summands;
+    BigInt x("4537141817592417305560");
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        x = x * 3 + BigInt(idx);
+        const BigInt summand = x % (BigInt(1) << (16 * (idx % 40) + 7));
+        summands.push_back(idx % 3 == 0 ? -summand : summand);
+    }
+    return summands;
+}
+
+static BigInt naive_sum(const std::vector<BigInt>& summands)
+{
+    BigInt res = 0;
+    for (const BigInt& summand : summands)
+        res = res + summand;
+    return res;
+}
+
+TEST_CASE( "BigIntAccumulator", "[accumulator]" ) {
+
+    SECTION( "small sums" ) {
+        BigIntAccumulator acc;
+        REQUIRE( acc.value() == 0 );
+        acc += 5;
+        acc += -7;
+        REQUIRE( acc.value() == -2 );
+        acc -= -2;
+        REQUIRE( acc.value() == 0 );
+        acc -= BigInt("4537141817592417305560");
+        REQUIRE( acc.value() == BigInt("-4537141817592417305560") );
+        acc.clear();
+        REQUIRE( acc.value() == 0 );
+    }
+
+    SECTION( "carries" ) {
+        // every addition carries into all higher limbs
+        const BigInt all_ones = (BigInt(1) << 1000) - 1;
+        BigIntAccumulator acc;
+        for (int idx = 0; idx < 100000; ++idx)
+            acc += all_ones;
+        REQUIRE( acc.value() == all_ones * 100000 );
+    }
+
+    SECTION( "compared with operator+" ) {
+        const std::vector<BigInt> summands = make_summands(2000);
+        BigIntAccumulator acc;
+        for (const BigInt& summand : summands)
+            acc += summand;
+        REQUIRE( acc.value() == naive_sum(summands) );
+
+        // merging
+        BigIntAccumulator other;
+        other -= summands[1];
+        other += acc;
+        REQUIRE( other.value() == naive_sum(summands) - summands[1] );
+    }
+
+    SECTION( "result resource" ) {
+        monotonic_buffer_resource arena;
+        BigIntAccumulator acc;
+        acc += BigInt("4537141817592417305560");
+        const BigInt res = acc.value(&arena);
+        REQUIRE( res.resource() == &arena );
+        REQUIRE( res == BigInt("4537141817592417305560") );
+    }
+
+}
+
+TEST_CASE( "ShardedBigIntAccumulator", "[accumulator]" ) {
+
+    const std::vector<BigInt> summands = make_summands(4000);
+    const size_t threads = 4;
+
+    for (size_t shards : {1, 3, 0})
+    {
+        ShardedBigIntAccumulator acc(shards);
+        std::vector<std::thread> workers;
+        for (size_t thread = 0; thread < threads; ++thread)
+            workers.emplace_back([&acc, &summands, thread]() {
+                for (size_t idx = thread; idx < summands.size(); idx += threads)
+                    acc += summands[idx];
+            });
+        for (std::thread& worker : workers)
+            worker.join();
+        REQUIRE( acc.value() == naive_sum(summands) );
+
+        acc -= acc.value();
+        REQUIRE( acc.value() == 0 );
+        acc.clear();
+        REQUIRE( acc.value() == 0 );
+    }
+
+}
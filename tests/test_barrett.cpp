@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "../exread/barrett.hpp"
+
+using namespace exread;
+
+// a mod m in [0, m)
+static BigInt mod(const BigInt& a, const BigInt& m)
+{
+    const BigInt res = a % m;
+    return res.is_negative() ? res + m : res;
+}
+
+TEST_CASE( "BarrettContext", "[barrett]" ) {
+
+    const BigInt m1("340282366920938463463374607431768211456000"); // 1000 * 2^128
+    const BigInt m2 = 65536;
+    const BigInt m3 = (BigInt(1) << 160) - 1;
+    const BigInt m4 = 1;
+
+    const BigInt a("98765432109876543210987654321098765432109876543210");
+    const BigInt b("-1234567890123456789012345678901234567890");
+
+    for (const BigInt& m : {m1, m2, m3, m4})
+    {
+        const BarrettContext ctx(m);
+        REQUIRE( ctx.modulus() == m );
+
+        const BigInt ar = ctx.reduce(a);
+        const BigInt br = ctx.reduce(b);
+        REQUIRE( ar == mod(a, m) );
+        REQUIRE( br == mod(b, m) );
+
+        REQUIRE( ctx.mul(ar, br) == mod(a * b, m) );
+        REQUIRE( ctx.sqr(br) == mod(b * b, m) );
+
+        // maximal operands
+        REQUIRE( ctx.sqr(m - 1) == mod(1, m) );
+        REQUIRE( ctx.reduce(m) == 0 );
+        REQUIRE( ctx.reduce(0) == 0 );
+    }
+
+}
+
+TEST_CASE( "BarrettContext invalid modulus", "[barrett]" ) {
+
+    REQUIRE_THROWS_AS( BarrettContext(BigInt(0)), std::invalid_argument );
+    REQUIRE_THROWS_AS( BarrettContext(BigInt(-8)), std::invalid_argument );
+
+}
@@ -0,0 +1,145 @@
+#include "catch.hpp"
+#include "../exread/bigfloat.hpp"
+#include "../exread/numtheory.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace exread;
+
+// doubles of varying magnitudes and signs with full 53 bit mantissas
+static std::vector<double> make_doubles(size_t count)
+{
+    std::vector<double> values;
+    unsigned long long state = 88172645463325252ull;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const double mantissa = double(state >> 11) / double(1ull << 53); // [0, 1)
+        values.push_back(std::ldexp(mantissa + 0.5, int(idx % 61) - 30) * (idx % 2 ? -1 : 1));
+    }
+    return values;
+}
+
+TEST_CASE( "BigFloat constructors", "[BigFloat]" ) {
+
+    SECTION( "exact values" ) {
+        const BigFloat x(BigInt(12), 10);
+        REQUIRE( x.mantissa() == 3 );
+        REQUIRE( x.exponent() == 2 );
+        REQUIRE( x.precision() == 10 );
+        REQUIRE( BigFloat(0.75).mantissa() == 3 );
+        REQUIRE( BigFloat(0.75).exponent() == -2 );
+        REQUIRE( BigFloat(-0.75) == -BigFloat(0.75) );
+        REQUIRE( BigFloat(0.0).is_zero() );
+        REQUIRE( BigFloat().is_zero() );
+        REQUIRE( ldexp(BigFloat(0.75), -3) == BigFloat(0.09375) );
+        REQUIRE( ldexp(BigFloat(), 5).exponent() == 0 );
+    }
+
+    SECTION( "rounding" ) {
+        // 0b10110 == 22 to three bits: 20 or 24, the tie goes to the even mantissa
+        REQUIRE( BigFloat(BigInt(22), 3) == BigFloat(BigInt(24)) );
+        REQUIRE( BigFloat(BigInt(22), 3, RoundingMode::toward_zero) == BigFloat(BigInt(20)) );
+        REQUIRE( BigFloat(BigInt(-22), 3, RoundingMode::upward) == BigFloat(BigInt(-20)) );
+        REQUIRE( BigFloat(BigInt(-22), 3, RoundingMode::downward) == BigFloat(BigInt(-24)) );
+        REQUIRE( BigFloat(BigInt(21), 3) == BigFloat(BigInt(20)) );
+        REQUIRE( BigFloat(BigInt(23), 3) == BigFloat(BigInt(24)) );
+        REQUIRE( BigFloat(BigInt(31), 3) == BigFloat(BigInt(32)) );
+        REQUIRE( BigFloat(0.1, 200) == BigFloat(0.1) );
+        REQUIRE( BigFloat(1.0 + std::ldexp(1.0, -30), 20) == BigFloat(1.0) );
+    }
+
+    SECTION( "invalid arguments" ) {
+        REQUIRE_THROWS_AS( BigFloat(BigInt(1), 0), std::invalid_argument );
+        REQUIRE_THROWS_AS( BigFloat(HUGE_VAL), std::invalid_argument );
+        REQUIRE_THROWS_AS( BigFloat(1.0) / BigFloat(), std::invalid_argument );
+        REQUIRE_THROWS_AS( sqrt(BigFloat(-1.0), 53), std::invalid_argument );
+    }
+
+}
+
+TEST_CASE( "BigFloat comparison", "[BigFloat]" ) {
+
+    REQUIRE( BigFloat(0.5) < BigFloat(0.75) );
+    REQUIRE( BigFloat(-0.75) < BigFloat(-0.5) );
+    REQUIRE( BigFloat(-0.5) < BigFloat() );
+    REQUIRE( BigFloat(3.0) > BigFloat(2.75) );
+    REQUIRE( BigFloat(1e300) > BigFloat(1e-300) );
+    REQUIRE( BigFloat(2.0).compare(BigFloat(BigInt(2), 100)) == 0 );
+
+}
+
+TEST_CASE( "BigFloat arithmetic compared with double", "[BigFloat]" ) {
+
+    // at 53 bits with rounding to nearest, every operation must agree with IEEE double
+    const std::vector<double> values = make_doubles(300);
+    for (size_t idx = 0; idx + 1 < values.size(); ++idx)
+    {
+        const double a = values[idx];
+        const double b = values[idx+1];
+        REQUIRE( BigFloat(a) + BigFloat(b) == BigFloat(a + b) );
+        REQUIRE( BigFloat(a) - BigFloat(b) == BigFloat(a - b) );
+        REQUIRE( BigFloat(a) * BigFloat(b) == BigFloat(a * b) );
+        REQUIRE( BigFloat(a) / BigFloat(b) == BigFloat(a / b) );
+        REQUIRE( sqrt(BigFloat(std::fabs(a)), 53) == BigFloat(std::sqrt(std::fabs(a))) );
+        REQUIRE( add(BigFloat(a), BigFloat(b * 1e-30), 53) == BigFloat(a + b * 1e-30) );
+    }
+
+}
+
+TEST_CASE( "BigFloat high precision", "[BigFloat]" ) {
+
+    const size_t prec = 500;
+    const BigFloat two(BigInt(2), prec);
+    const BigFloat ulp(std::ldexp(1.0, 1 - int(prec))); // in [1, 2)
+
+    SECTION( "square root of two" ) {
+        // the roots rounded down and up bracket sqrt(2) one unit in the last place apart
+        const BigFloat down = sqrt(two, prec, RoundingMode::downward);
+        const BigFloat up = sqrt(two, prec, RoundingMode::upward);
+        REQUIRE( mul(down, down, 2*prec) < two );
+        REQUIRE( mul(up, up, 2*prec) > two );
+        REQUIRE( sub(up, down, prec) == ulp );
+        REQUIRE( down == mul(BigFloat(isqrt(BigInt(1) << (2*prec - 1)), prec), ulp, prec) );
+
+        const BigFloat nearest = sqrt(two, prec);
+        REQUIRE( (nearest == down || nearest == up) );
+    }
+
+    SECTION( "division" ) {
+        // 1/3 == 0.0101...01|0101... in binary rounds up at any precision
+        const BigFloat third = div(BigFloat(1.0), BigFloat(3.0), prec);
+        REQUIRE( third.precision() == prec );
+        REQUIRE( third.mantissa().bit_length() == prec );
+        REQUIRE( mul(third, BigFloat(3.0), prec) == BigFloat(1.0) );
+        REQUIRE( div(BigFloat(1.0), BigFloat(3.0), prec, RoundingMode::toward_zero) < third );
+    }
+
+    SECTION( "operands beyond the target precision" ) {
+        const BigInt m = pow(BigInt(3), 5000);
+        const BigInt n = pow(BigInt(7), 3000);
+        const BigFloat x(m, 8000);
+        const BigFloat y(n, 9000);
+        REQUIRE( mul(x, y, 64) == BigFloat(m * n, 64) );
+        REQUIRE( mul(x, y, 64, RoundingMode::upward) == BigFloat(m * n, 64, RoundingMode::upward) );
+
+        const BigFloat q = div(x, y, 64, RoundingMode::toward_zero);
+        const BigFloat q_up = div(x, y, 64, RoundingMode::upward);
+        REQUIRE( mul(q, y, 20000) < x );
+        REQUIRE( mul(q_up, y, 20000) > x );
+
+        REQUIRE( sqrt(x, 64, RoundingMode::toward_zero) == BigFloat(isqrt(m), 64, RoundingMode::toward_zero) );
+
+        // (2^200 + 1) * (2^40 + 1) to 40 bits: the truncated product is the midpoint
+        // 2^240 + 2^200, and only the cut-off bits decide to round up
+        const BigInt u = (BigInt(1) << 200) + 1;
+        const BigInt v = (BigInt(1) << 40) + 1;
+        const BigFloat product = mul(BigFloat(u, 300), BigFloat(v, 300), 40);
+        REQUIRE( product == BigFloat(u * v, 40) );
+        REQUIRE( product == BigFloat((BigInt(1) << 240) + (BigInt(1) << 201)) );
+    }
+
+}
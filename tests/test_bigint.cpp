@@ -1,6 +1,8 @@
 #include "catch.hpp"
 #include "../exread/bigint.hpp"
 
+#include <cmath>
+
 using namespace exread;
 
 TEST_CASE( "operator ==,!=", "[BigInt]" ) {
@@ -98,6 +100,29 @@ TEST_CASE( "comparison operators >, <", "[BigInt]" ) {
     REQUIRE( !(i3 > i2) );
 }
 
+TEST_CASE( "compare, cmp_abs", "[BigInt]" ) {
+
+    const BigInt i1( 100);
+    const BigInt i2(  99);
+    const BigInt i3(-100);
+    const BigInt i4(- 99);
+    const BigInt zero;
+
+    REQUIRE( i1.compare(i2) ==  1 );
+    REQUIRE( i2.compare(i1) == -1 );
+    REQUIRE( i1.compare(i1) ==  0 );
+    REQUIRE( i3.compare(i4) == -1 );
+    REQUIRE( i4.compare(i3) ==  1 );
+    REQUIRE( i3.compare(i2) == -1 );
+    REQUIRE( zero.compare(i4) ==  1 );
+    REQUIRE( zero.compare(zero) ==  0 );
+
+    REQUIRE( i3.cmp_abs(i1) ==  0 );
+    REQUIRE( i3.cmp_abs(i2) ==  1 );
+    REQUIRE( i4.cmp_abs(i1) == -1 );
+    REQUIRE( zero.cmp_abs(i4) == -1 );
+}
+
 TEST_CASE( "unary arithmetic operators", "[BigInt]" ) {
 
     const long long int n = -89368532769232346342343406;
@@ -173,6 +198,23 @@ TEST_CASE( "binary arithmetic operators", "[BigInt]" ) {
         REQUIRE( (-i7)       * BigInt(0) == 0 );
     }
 
+    SECTION( "operator %") {
+        REQUIRE( i2 % i1 == i2 );
+        REQUIRE( BigInt(634) % BigInt(10) == 4 );
+
+        REQUIRE( ( i1) % ( i2) ==  i1 - i2 * 85225300017 );
+        REQUIRE( (-i1) % ( i2) == -i1 + i2 * 85225300017 );
+        REQUIRE( (-i1) % (-i2) == -i1 + i2 * 85225300017 );
+        REQUIRE( ( i1) % (-i2) ==  i1 - i2 * 85225300017 );
+
+        REQUIRE( (i6 * i5 + (i6-1)) % i6  ==  i6 - 1 );
+        REQUIRE( (i6 * i5 +  i6   ) % i6  ==  0 );
+        REQUIRE( (i6 * i5 +  94   ) % i5  ==  94 % n5 );
+
+        REQUIRE_THROWS_AS(BigInt(23) % BigInt(0), std::invalid_argument);
+        REQUIRE_THROWS_WITH(BigInt(23) % BigInt(0), "Division by BigInt(0)");
+    }
+
     SECTION( "operator /") {
         REQUIRE( i2 / i1 == 0 );
 
@@ -201,6 +243,98 @@ TEST_CASE( "binary arithmetic operators", "[BigInt]" ) {
 
 }
 
+TEST_CASE( "pow", "[BigInt]" ) {
+
+    const BigInt i1("4537141817592417305560");
+
+    SECTION( "small powers" ) {
+        REQUIRE( pow(i1, 0) == 1 );
+        REQUIRE( pow(BigInt(0), 0) == 1 );
+        REQUIRE( pow(BigInt(0), 5) == 0 );
+        REQUIRE( pow(i1, 1) == i1 );
+        REQUIRE( pow(i1, 2) == i1 * i1 );
+        REQUIRE( pow(-i1, 3) == -i1 * i1 * i1 );
+        REQUIRE( pow(-i1, 4) == i1 * i1 * i1 * i1 );
+        REQUIRE( pow(BigInt(10), 11) == 100000000000 );
+        REQUIRE( pow(BigInt(-3), 39) == -4052555153018976267 );
+    }
+
+    SECTION( "powers of two" ) {
+        REQUIRE( pow(BigInt(2), 1000) == BigInt(1) << 1000 );
+        REQUIRE( pow(BigInt(-65536), 7) == -(BigInt(1) << 112) );
+        REQUIRE( pow(BigInt(1) << 40, 30) == BigInt(1) << 1200 );
+        REQUIRE( pow(BigInt(-1), 12345) == -1 );
+    }
+
+    SECTION( "large exponents" ) {
+        // repeated multiplication as reference; beyond the Karatsuba threshold
+        BigInt expected = 1;
+        for (int idx = 0; idx < 300; ++idx)
+            expected = expected * i1;
+        REQUIRE( pow(i1, 300) == expected );
+        REQUIRE( pow(i1 * 12, 300) == expected * pow(BigInt(12), 300) );
+        REQUIRE( pow(pow(i1, 20), 15) == expected );
+    }
+
+}
+
+TEST_CASE( "addmul, submul", "[BigInt]" ) {
+
+    const BigInt i1("4537141817592417305560");
+    const BigInt i2("-98765432109876543210987654321");
+    const BigInt big = pow(i1, 20); // beyond the row-by-row limit
+
+    SECTION( "BigInt factors" ) {
+        for (const BigInt& acc : {BigInt(0), i1, i2, -big, big * 3})
+            for (const BigInt& a : {BigInt(0), i1, i2, big})
+                for (const BigInt& b : {BigInt(1), i2, -big})
+                {
+                    BigInt res = acc;
+                    addmul(res, a, b);
+                    REQUIRE( res == acc + a * b );
+                    res = acc;
+                    submul(res, a, b);
+                    REQUIRE( res == acc - a * b );
+                }
+    }
+
+    SECTION( "builtin factors" ) {
+        for (const BigInt& acc : {BigInt(0), i1, i2, -big})
+            for (long long b : {0ll, 1ll, -7ll, 65535ll, 65536ll, -4052555153018976267ll})
+            {
+                BigInt res = acc;
+                addmul(res, i2, b);
+                REQUIRE( res == acc + i2 * b );
+                res = acc;
+                submul(res, i2, b);
+                REQUIRE( res == acc - i2 * b );
+            }
+
+        BigInt res = i1;
+        addmul(res, i1, 0xFFFFFFFFFFFFFFFFull);
+        REQUIRE( res == i1 * BigInt("18446744073709551616") );
+    }
+
+    SECTION( "cancellation" ) {
+        BigInt res = i1 * i2;
+        submul(res, i1, i2);
+        REQUIRE( res == 0 );
+        res = i1 * 12345;
+        submul(res, i1, 12345);
+        REQUIRE( res == 0 );
+    }
+
+    SECTION( "aliased operands" ) {
+        BigInt res = i1;
+        addmul(res, res, res);
+        REQUIRE( res == i1 + i1 * i1 );
+        res = i2;
+        submul(res, res, 3);
+        REQUIRE( res == i2 * -2 );
+    }
+
+}
+
 TEST_CASE( "string constructor", "[BigInt]" ) {
 
     SECTION( "invalid argument" ) {
@@ -231,4 +365,226 @@ TEST_CASE( "string constructor", "[BigInt]" ) {
 
     }
 
+    SECTION( "zero" ) {
+
+        REQUIRE( BigInt("0") == 0 );
+        REQUIRE( BigInt("-0") == 0 );
+        REQUIRE( !BigInt("-0").is_negative() );
+        REQUIRE( BigInt("-000120") == -120 );
+
+    }
+
+}
+
+TEST_CASE( "literals", "[BigInt]" ) {
+
+    REQUIRE( 0_big == 0 );
+    REQUIRE( 12345_big == 12345 );
+    REQUIRE( -12345_big == -12345 );
+    REQUIRE( 4537141817592417305560_big == BigInt("4537141817592417305560") );
+    REQUIRE( 4'537'141'817'592'417'305'560_big == BigInt("4537141817592417305560") );
+    REQUIRE( 0xffffffffffffffffffff_big == BigInt("1208925819614629174706175") );
+    REQUIRE( 0b1000000000000000000000000000000000000000000000000000000000000000000_big == BigInt("73786976294838206464") );
+    REQUIRE( 0777_big == 511 );
+
+    // every base, with upper case prefixes and digits, and separators
+    REQUIRE( 0XDEAD'BEEF_big == 0xDEADBEEF );
+    REQUIRE( 0xAbCdEf_big == 0xABCDEF );
+    REQUIRE( 0B1010'1010_big == 170 );
+    REQUIRE( 0b0_big == 0 );
+    REQUIRE( 00_big == 0 );
+    REQUIRE( 0'17_big == 15 );
+    REQUIRE( 9_big == 9 );
+
+    // floating literals and digits beyond the base are rejected at compile time
+    using literal_detail::is_integer;
+    REQUIRE( is_integer<'1', '2', '3'>() );
+    REQUIRE( is_integer<'0', 'x', 'f', 'F'>() );
+    REQUIRE( is_integer<'0', 'x', '1', 'e', '5'>() );
+    REQUIRE( !is_integer<'1', '.', '5'>() );
+    REQUIRE( !is_integer<'1', 'e', '5'>() );
+    REQUIRE( !is_integer<'1', 'e', '-', '5'>() );
+    REQUIRE( !is_integer<'0', 'x', '1', 'p', '5'>() );
+    REQUIRE( !is_integer<'0', 'x', '1', '.', '8', 'p', '1'>() );
+    REQUIRE( !is_integer<'0', '8'>() );
+    REQUIRE( !is_integer<'0', 'b', '1', '2'>() );
+    REQUIRE( !is_integer<'1', 'a'>() );
+
+}
+
+TEST_CASE( "shift operators", "[BigInt]" ) {
+
+    const BigInt i1("4537141817592417305560");
+    const BigInt i2 = -i1;
+
+    SECTION( "operator <<" ) {
+        REQUIRE( (i1 << 0) == i1 );
+        REQUIRE( (i1 << 1) == i1 * 2 );
+        REQUIRE( (i1 << 16) == i1 * 65536 );
+        REQUIRE( (i1 << 67) == i1 * 8 * BigInt(1ull << 32) * BigInt(1ull << 32) );
+        REQUIRE( (i2 << 35) == i2 * BigInt(1ull << 35) );
+        REQUIRE( (BigInt(0) << 100) == 0 );
+    }
+
+    SECTION( "operator >>" ) {
+        REQUIRE( (i1 >> 0) == i1 );
+        REQUIRE( (i1 >> 3) == i1 / 8 );
+        REQUIRE( (i1 >> 32) == i1 / BigInt(1ull << 32) );
+        REQUIRE( (i1 >> 1000) == 0 );
+
+        // negative numbers round towards negative infinity
+        REQUIRE( (i2 >> 3) == i2 / 8 );
+        REQUIRE( (i2 >> 4) == i2 / 16 - 1 );
+        REQUIRE( (i2 >> 1000) == -1 );
+        REQUIRE( (BigInt(-65536) >> 16) == -1 );
+        REQUIRE( (BigInt(-65537) >> 16) == -2 );
+    }
+
+    SECTION( "in place" ) {
+        BigInt i = i2;
+        i <<= 45;
+        i >>= 45;
+        REQUIRE( i == i2 );
+    }
+
+    SECTION( "compared with builtin integers" ) {
+        for (long long n = -300; n <= 300; n += 7)
+            for (size_t count = 0; count < 20; ++count)
+            {
+                REQUIRE( (BigInt(n) << count) == n * (1ll << count) );
+                REQUIRE( (BigInt(n) >> count) == (n >> count) );
+            }
+    }
+
+}
+
+TEST_CASE( "bitwise operators", "[BigInt]" ) {
+
+    SECTION( "compared with builtin integers" ) {
+        for (long long n1 = -70000; n1 <= 70000; n1 += 4567)
+            for (long long n2 = -70000; n2 <= 70000; n2 += 3989)
+            {
+                REQUIRE( (BigInt(n1) & BigInt(n2)) == (n1 & n2) );
+                REQUIRE( (BigInt(n1) | BigInt(n2)) == (n1 | n2) );
+                REQUIRE( (BigInt(n1) ^ BigInt(n2)) == (n1 ^ n2) );
+            }
+        for (long long n = -70000; n <= 70000; n += 4567)
+            REQUIRE( ~BigInt(n) == ~n );
+        REQUIRE( ~BigInt(0) == -1 );
+        REQUIRE( ~BigInt(-1) == 0 );
+    }
+
+    SECTION( "large operands" ) {
+        const BigInt i1 = (BigInt(1) << 100) - 1;
+        const BigInt i2 = BigInt(1) << 64;
+
+        REQUIRE( (i1 & i2) == i2 );
+        REQUIRE( (i1 & -i2) == i1 - (i2 - 1) );
+        REQUIRE( (-i1 & -i2) == -(BigInt(1) << 100) );
+        REQUIRE( (i1 | -i2) == -1 );
+        REQUIRE( (i2 | 1) == i2 + 1 );
+        REQUIRE( (i1 ^ i2) == i1 - i2 );
+        REQUIRE( (-i1 ^ -i1) == 0 );
+        REQUIRE( (i1 ^ -1) == ~i1 );
+    }
+
+    SECTION( "in place" ) {
+        BigInt i = BigInt(1) << 80;
+        i |= 5;
+        i &= ~BigInt(1);
+        i ^= BigInt(1) << 80;
+        REQUIRE( i == 4 );
+    }
+
+}
+
+TEST_CASE( "bit queries", "[BigInt]" ) {
+
+    const BigInt i1 = (BigInt(1) << 100) + (BigInt(1) << 37) + 8;
+
+    SECTION( "bit_length, popcount, countr_zero" ) {
+        REQUIRE( BigInt(0).bit_length() == 0 );
+        REQUIRE( BigInt(1).bit_length() == 1 );
+        REQUIRE( BigInt(65535).bit_length() == 16 );
+        REQUIRE( BigInt(65536).bit_length() == 17 );
+        REQUIRE( i1.bit_length() == 101 );
+        REQUIRE( (-i1).bit_length() == 101 );
+
+        REQUIRE( BigInt(0).popcount() == 0 );
+        REQUIRE( i1.popcount() == 3 );
+        REQUIRE( (-i1).popcount() == 3 );
+        REQUIRE( ((BigInt(1) << 200) - 1).popcount() == 200 );
+
+        REQUIRE( BigInt(0).countr_zero() == 0 );
+        REQUIRE( i1.countr_zero() == 3 );
+        REQUIRE( (BigInt(-1) << 77).countr_zero() == 77 );
+    }
+
+    SECTION( "test_bit" ) {
+        REQUIRE( i1.test_bit(100) );
+        REQUIRE( i1.test_bit(37) );
+        REQUIRE( !i1.test_bit(36) );
+        REQUIRE( !i1.test_bit(1000) );
+
+        for (long long n = -1000; n <= 1000; n += 37)
+            for (size_t idx = 0; idx < 20; ++idx)
+                REQUIRE( BigInt(n).test_bit(idx) == bool((n >> idx) & 1) );
+        REQUIRE( BigInt(-5).test_bit(1000) );
+    }
+
+    SECTION( "set_bit, clear_bit" ) {
+        BigInt i = i1;
+        i.clear_bit(100).clear_bit(37).set_bit(0);
+        REQUIRE( i == 9 );
+        i.set_bit(64);
+        REQUIRE( i == (BigInt(1) << 64) + 9 );
+
+        for (long long n = -1000; n <= 1000; n += 37)
+            for (size_t idx = 0; idx < 20; ++idx)
+            {
+                REQUIRE( BigInt(n).set_bit(idx) == (n | (1ll << idx)) );
+                REQUIRE( BigInt(n).clear_bit(idx) == (n & ~(1ll << idx)) );
+            }
+
+        REQUIRE( BigInt(-1).clear_bit(70) == -(BigInt(1) << 70) - 1 );
+        REQUIRE( (-(BigInt(1) << 70)).set_bit(3) == -(BigInt(1) << 70) + 8 );
+    }
+
+}
+
+TEST_CASE( "to_double", "[BigInt]" ) {
+
+    SECTION( "exact values" ) {
+        REQUIRE( BigInt().to_double() == 0. );
+        REQUIRE( BigInt(-12345).to_double() == -12345. );
+        REQUIRE( (BigInt(1) << 53).to_double() == 9007199254740992. );
+        REQUIRE( BigInt(9007199254740991ll).to_double() == 9007199254740991. );
+        REQUIRE( (BigInt(1) << 1000).to_double() == std::ldexp(1., 1000) );
+        REQUIRE( (-(BigInt(1) << 1023)).to_double() == -std::ldexp(1., 1023) );
+    }
+
+    SECTION( "rounding" ) {
+        const BigInt two53 = BigInt(1) << 53;
+        REQUIRE( (two53 + 1).to_double() == 9007199254740992. ); // tie, to even
+        REQUIRE( (two53 + 3).to_double() == 9007199254740996. ); // tie, to even
+        REQUIRE( (-(two53 + 3)).to_double() == -9007199254740996. );
+
+        // ties decided by a set bit far below the top 64 bits
+        const BigInt tie = (two53 + 1) << 200;
+        REQUIRE( tie.to_double() == std::ldexp(1., 253) );
+        REQUIRE( (tie + 1).to_double() == std::ldexp(9007199254740994., 200) );
+        REQUIRE( (tie - 1).to_double() == std::ldexp(1., 253) );
+
+        for (long long n = 1; n < (1ll << 62); n = n * 3 + 1)
+            REQUIRE( BigInt(n).to_double() == double(n) );
+    }
+
+    SECTION( "overflow" ) {
+        const BigInt max = ((BigInt(1) << 53) - 1) << 971; // DBL_MAX
+        REQUIRE( max.to_double() == std::numeric_limits<double>::max() );
+        REQUIRE( (max + (BigInt(1) << 970) - 1).to_double() == std::numeric_limits<double>::max() );
+        REQUIRE( (max + (BigInt(1) << 970)).to_double() == HUGE_VAL ); // tie, to even 2^1024
+        REQUIRE( (-(BigInt(1) << 5000)).to_double() == -HUGE_VAL );
+    }
+
 }
@@ -0,0 +1,71 @@
+#include "catch.hpp"
+#include "../exread/combinatorics.hpp"
+
+using namespace exread;
+
+// n! by repeated multiplication
+static BigInt naive_factorial(unsigned long n)
+{
+    BigInt res = 1;
+    for (unsigned long idx = 2; idx <= n; ++idx)
+        res = res * BigInt(idx);
+    return res;
+}
+
+TEST_CASE( "factorial", "[combinatorics]" ) {
+
+    SECTION( "small arguments" ) {
+        REQUIRE( factorial(0) == 1 );
+        REQUIRE( factorial(1) == 1 );
+        REQUIRE( factorial(20) == 2432902008176640000 );
+        REQUIRE( factorial(25) == BigInt("15511210043330985984000000") );
+    }
+
+    SECTION( "compared with repeated multiplication" ) {
+        for (unsigned long n = 0; n <= 300; ++n)
+            REQUIRE( factorial(n) == naive_factorial(n) );
+        REQUIRE( factorial(5000) == naive_factorial(5000) );
+    }
+
+}
+
+TEST_CASE( "binomial", "[combinatorics]" ) {
+
+    SECTION( "small arguments" ) {
+        REQUIRE( binomial(0, 0) == 1 );
+        REQUIRE( binomial(5, 0) == 1 );
+        REQUIRE( binomial(5, 5) == 1 );
+        REQUIRE( binomial(5, 6) == 0 );
+        REQUIRE( binomial(10, 3) == 120 );
+        REQUIRE( binomial(100, 50) == BigInt("100891344545564193334812497256") );
+    }
+
+    SECTION( "Pascal's triangle" ) {
+        for (unsigned long n = 1; n <= 200; ++n)
+            for (unsigned long k = 1; k <= n; ++k)
+                REQUIRE( binomial(n, k) == binomial(n-1, k-1) + binomial(n-1, k) );
+    }
+
+    SECTION( "large arguments" ) {
+        REQUIRE( binomial(4000, 1500) * factorial(1500) * factorial(2500) == factorial(4000) );
+        REQUIRE( binomial(100000, 3) == BigInt(100000) * 99999 * 99998 / 6 );
+        REQUIRE( binomial(4000000000ul, 2) == BigInt(4000000000ul) * 3999999999ul / 2 );
+    }
+
+}
+
+TEST_CASE( "primorial", "[combinatorics]" ) {
+
+    REQUIRE( primorial(0) == 1 );
+    REQUIRE( primorial(1) == 1 );
+    REQUIRE( primorial(2) == 2 );
+    REQUIRE( primorial(30) == 6469693230 );
+    REQUIRE( primorial(31) == BigInt(6469693230) * 31 );
+
+    // a prime divides n# exactly once
+    const BigInt p = primorial(1000);
+    REQUIRE( p % 997 == 0 );
+    REQUIRE( (p / 997) % 997 != 0 );
+    REQUIRE( p % 1009 != 0 );
+
+}
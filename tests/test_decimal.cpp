@@ -0,0 +1,121 @@
+#include "catch.hpp"
+#include "../exread/decimal.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+using namespace exread;
+
+TEST_CASE( "read_decimal", "[decimal]" ) {
+
+    SECTION( "significand and exponent" ) {
+        const DecimalNumber d = read_decimal("-123.4500e-17");
+        REQUIRE( d.significand == -12345 );
+        REQUIRE( d.exponent == -19 );
+
+        REQUIRE( read_decimal("1000").significand == 1 );
+        REQUIRE( read_decimal("1000").exponent == 3 );
+        REQUIRE( read_decimal("+.5").exponent == -1 );
+        REQUIRE( read_decimal("5.").exponent == 0 );
+        REQUIRE( read_decimal("0042.0E+3").significand == 42 );
+        REQUIRE( read_decimal("0042.0E+3").exponent == 3 );
+        REQUIRE( read_decimal("7e-0000000000000000000000005").exponent == -5 );
+
+        const std::string digits = "45371418175924173055609876543210987654321098765432107";
+        REQUIRE( read_decimal(digits + "." + digits).significand == BigInt(digits + digits) );
+        REQUIRE( read_decimal(digits + "." + digits).exponent == -long(digits.size()) );
+    }
+
+    SECTION( "zero" ) {
+        for (const char* s : {"0", "-0", "+0.000", ".0", "0e99", "-00.e-7"})
+        {
+            const DecimalNumber d = read_decimal(s);
+            REQUIRE( d.significand == 0 );
+            REQUIRE( !d.significand.is_negative() );
+            REQUIRE( d.exponent == 0 );
+        }
+    }
+
+    SECTION( "invalid strings" ) {
+        for (const char* s : {"", "-", "+", ".", "-.", "e5", ".e1", "1e", "1e+", "1.2.3", " 1", "1 ", "1e5.0", "0x1", "1f", "--1", "1e--1"})
+            REQUIRE_THROWS_AS( read_decimal(s), std::invalid_argument );
+        REQUIRE_THROWS_WITH( read_decimal("1,5"), "read_decimal(\"1,5\")" );
+        REQUIRE_THROWS_AS( read_decimal("1e99999999999999999999"), std::invalid_argument );
+    }
+
+}
+
+TEST_CASE( "read_rational", "[decimal]" ) {
+
+    REQUIRE( read_rational("-123.4500e-17") == Rational(BigInt(-2469), BigInt(200)) / pow(BigInt(10), 16) );
+    REQUIRE( read_rational("0.125") == Rational(BigInt(1), BigInt(8)) );
+    REQUIRE( read_rational("-2.5e3") == -2500 );
+    REQUIRE( read_rational("3.14159").denominator() == 100000 );
+    REQUIRE( read_rational("1e-30").numerator() == 1 );
+    REQUIRE( read_rational("1e-30").denominator() == pow(BigInt(10), 30) );
+    REQUIRE( read_rational("-0.0") == 0 );
+    REQUIRE( to_rational({BigInt(3), 2}) == 300 );
+
+}
+
+TEST_CASE( "read_double", "[decimal]" ) {
+
+    SECTION( "fast paths" ) {
+        REQUIRE( read_double("0.1") == 0.1 );
+        REQUIRE( read_double("-123.4500e-17") == -123.45e-17 );
+        REQUIRE( read_double("1e22") == 1e22 );
+        REQUIRE( read_double("1e23") == 1e23 );
+        REQUIRE( read_double("2.2250738585072014e-308") == std::numeric_limits<double>::min() );
+        REQUIRE( read_double("1.7976931348623157e308") == std::numeric_limits<double>::max() );
+        REQUIRE( read_double("3.141592653589793238462643383279502884197169399375105820974944") == 3.141592653589793 );
+    }
+
+    SECTION( "ties and near ties" ) {
+        // 2^53 + 1 is halfway between two doubles, the following digits decide
+        REQUIRE( read_double("9007199254740993") == 9007199254740992. );
+        REQUIRE( read_double("9007199254740993.0000000000000000000000000000001") == 9007199254740994. );
+        REQUIRE( read_double("9007199254740992.9999999999999999999999999999999") == 9007199254740992. );
+        REQUIRE( read_double("9007199254740995") == 9007199254740996. );
+
+        // halfway between 1 and the next double
+        const std::string half_ulp = "1.00000000000000011102230246251565404236316680908203125";
+        REQUIRE( read_double(half_ulp) == 1. );
+        REQUIRE( read_double(half_ulp + "1") == 1. + std::numeric_limits<double>::epsilon() );
+        REQUIRE( read_double(half_ulp + "e0") == 1. );
+        REQUIRE( read_double(std::string(half_ulp).replace(half_ulp.size() - 1, 1, "4")) == 1. );
+    }
+
+    SECTION( "subnormals, zeros and infinities" ) {
+        REQUIRE( read_double("4.9406564584124654e-324") == std::numeric_limits<double>::denorm_min() );
+        REQUIRE( read_double("2.4703282292062328e-324") == std::numeric_limits<double>::denorm_min() );
+        REQUIRE( read_double("2.4703282292062327e-324") == 0. );
+        REQUIRE( read_double("1e-400") == 0. );
+        REQUIRE( std::signbit(read_double("-1e-400")) );
+        REQUIRE( std::signbit(read_double("-0.0")) );
+        REQUIRE( read_double("2.2250738585072011e-308") == std::strtod("2.2250738585072011e-308", nullptr) );
+        REQUIRE( read_double("1.8e308") == HUGE_VAL );
+        REQUIRE( read_double("-1e99999999999999999999") == -HUGE_VAL );
+        REQUIRE( read_double("1e-99999999999999999999") == 0. );
+    }
+
+    SECTION( "agreement with strtod" ) {
+        unsigned long long state = 88172645463325252ull;
+        for (int idx = 0; idx < 2000; ++idx)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            const std::string s = std::to_string(state >> (state % 40)) + "e" + std::to_string(int(state % 700) - 350);
+            REQUIRE( read_double(s) == std::strtod(s.c_str(), nullptr) );
+        }
+    }
+
+    SECTION( "invalid strings" ) {
+        REQUIRE_THROWS_WITH( read_double("1.5f"), "read_double(\"1.5f\")" );
+        REQUIRE_THROWS_AS( read_double(""), std::invalid_argument );
+        REQUIRE_THROWS_AS( read_double("inf"), std::invalid_argument );
+    }
+
+}
@@ -0,0 +1,123 @@
+#include "catch.hpp"
+#include "../exread/fixedint.hpp"
+
+using namespace exread;
+
+// a - (a / m) * m for a >= 0
+static BigInt mod(const BigInt& a, const BigInt& m)
+{
+    return a - (a / m) * m;
+}
+
+TEST_CASE( "FixedUInt", "[FixedInt]" ) {
+
+    using U128 = FixedUInt<128>;
+    const BigInt two_128 = BigInt(1ull << 32) * BigInt(1ull << 32) * BigInt(1ull << 32) * BigInt(1ull << 32);
+
+    const BigInt i1("288230376151711717123456789");
+    const BigInt i2("170141183460469231731687303715884105727"); // 2^127 - 1
+    const U128 u1(i1);
+    const U128 u2(i2);
+
+    SECTION( "conversion" ) {
+        REQUIRE( u1.to_bigint() == i1 );
+        REQUIRE( u2.to_bigint() == i2 );
+        REQUIRE( U128(12345).to_bigint() == 12345 );
+        REQUIRE( U128(-1).to_bigint() == two_128 - 1 );
+
+        REQUIRE_THROWS_AS( U128(two_128), std::out_of_range );
+        REQUIRE_THROWS_AS( U128(-i1), std::out_of_range );
+    }
+
+    SECTION( "arithmetic wraps around" ) {
+        REQUIRE( (u1 + u2).to_bigint() == i1 + i2 );
+        REQUIRE( (u2 + u2 + u2).to_bigint() == i2 + i2 + i2 - two_128 );
+        REQUIRE( (u1 - u2).to_bigint() == i1 - i2 + two_128 );
+        REQUIRE( (u1 * u2).to_bigint() == mod(i1 * i2, two_128) );
+        REQUIRE( (-u1).to_bigint() == two_128 - i1 );
+    }
+
+    SECTION( "division" ) {
+        REQUIRE( (u2 / u1).to_bigint() == i2 / i1 );
+        REQUIRE( (u2 % u1).to_bigint() == mod(i2, i1) );
+        REQUIRE( (u1 / u2) == 0 );
+        REQUIRE( (u1 % u2) == u1 );
+        REQUIRE( (u2 / 7).to_bigint() == i2 / 7 );
+
+        REQUIRE_THROWS_AS( u1 / U128(), std::invalid_argument );
+        REQUIRE_THROWS_WITH( u1 / U128(), "Division by FixedUInt(0)" );
+    }
+
+    SECTION( "shifts" ) {
+        REQUIRE( (U128(1) << 127).to_bigint() == two_128 / 2 );
+        REQUIRE( (U128(1) << 128) == 0 );
+        REQUIRE( (u2 >> 100).to_bigint() == i2 / BigInt(1 << 25) / BigInt(1 << 25) / BigInt(1 << 25) / BigInt(1 << 25) );
+        REQUIRE( ((u1 << 16) >> 16) == u1 );
+    }
+
+    SECTION( "comparison" ) {
+        REQUIRE( u1 < u2 );
+        REQUIRE( u2 > u1 );
+        REQUIRE( u1 != u2 );
+        REQUIRE( u1 == U128(i1) );
+        REQUIRE( U128(-1) > u2 );
+    }
+
+}
+
+TEST_CASE( "FixedInt", "[FixedInt]" ) {
+
+    using I256 = FixedInt<256>;
+
+    const BigInt i1("-57896044618658097711785492504343953926634992332820282019728792003956564819968"); // -2^255
+    const BigInt i2("340282366920938463463374607431768211457");
+    const BigInt i3("-98765432109876543210");
+
+    SECTION( "conversion" ) {
+        REQUIRE( I256(i1).to_bigint() == i1 );
+        REQUIRE( I256(i2).to_bigint() == i2 );
+        REQUIRE( I256(i3).to_bigint() == i3 );
+        REQUIRE( I256(-42).to_bigint() == -42 );
+        REQUIRE( I256(-42).is_negative() );
+
+        REQUIRE_THROWS_AS( I256(-i1), std::out_of_range );
+        REQUIRE_THROWS_AS( I256(i1 - 1), std::out_of_range );
+    }
+
+    SECTION( "arithmetic" ) {
+        const I256 f2(i2), f3(i3);
+        REQUIRE( (f2 + f3).to_bigint() == i2 + i3 );
+        REQUIRE( (f3 - f2).to_bigint() == i3 - i2 );
+        REQUIRE( (f2 * f3).to_bigint() == i2 * i3 );
+        REQUIRE( (f3 * f3).to_bigint() == i3 * i3 );
+        REQUIRE( (-f3).to_bigint() == -i3 );
+
+        // wrap around
+        REQUIRE( (I256(i1) - 1).to_bigint() == -(i1 + 1) );
+    }
+
+    SECTION( "division truncates towards zero" ) {
+        const I256 f2(i2), f3(i3);
+        REQUIRE( (f2 / f3).to_bigint() == i2 / i3 );
+        REQUIRE( (f3 / 7).to_bigint() == i3 / 7 );
+        REQUIRE( (I256(-7) / 2) == -3 );
+        REQUIRE( (I256(-7) % 2) == -1 );
+        REQUIRE( (I256( 7) % -2) == 1 );
+    }
+
+    SECTION( "shifts" ) {
+        REQUIRE( (I256(-7) >> 1) == -4 );
+        REQUIRE( (I256(-1) >> 200) == -1 );
+        REQUIRE( (I256(i3) << 3).to_bigint() == i3 * 8 );
+        REQUIRE( (I256(1) << 255).to_bigint() == i1 );
+    }
+
+    SECTION( "comparison" ) {
+        REQUIRE( I256(i1) < I256(i3) );
+        REQUIRE( I256(i3) < 0 );
+        REQUIRE( I256(i3) < I256(i2) );
+        REQUIRE( I256(i2) > 0 );
+        REQUIRE( I256(0) >= 0 );
+    }
+
+}
@@ -0,0 +1,228 @@
+#include "catch.hpp"
+#include "../exread/accumulator.hpp"
+#include "../exread/bigint.hpp"
+#include "../exread/memory.hpp"
+#include "../exread/montgomery.hpp"
+#include "../src/scratch.hpp"
+
+#include <algorithm> // std::min
+#include <cstring> // std::memcpy
+
+using namespace exread;
+
+// forwards to new_delete_resource() and counts live allocations
+class counting_resource : public memory_resource
+{
+    public:
+
+        int allocations = 0;
+        int live = 0;
+
+    private:
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            ++live;
+            return new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            --live;
+            new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+};
+
+TEST_CASE( "BigInt with memory_resource", "[memory]" ) {
+
+    counting_resource counter;
+
+    SECTION( "results use the resource of the left operand" ) {
+        {
+            const BigInt i1(4536546846465102347, &counter);
+            const BigInt i2(-89368532769232346);
+            REQUIRE( i1.resource() == &counter );
+            REQUIRE( i2.resource() == get_default_resource() );
+
+            REQUIRE( (i1 + i2).resource() == &counter );
+            REQUIRE( (i1 - i2).resource() == &counter );
+            REQUIRE( (i1 * i2).resource() == &counter );
+            REQUIRE( (i1 / i2).resource() == &counter );
+            REQUIRE( (-i1).resource() == &counter );
+            REQUIRE( (i2 * i1).resource() == get_default_resource() );
+
+            REQUIRE( counter.allocations > 0 );
+            REQUIRE( BigInt(i1 * i2, &counter) == i2 * i1 );
+        }
+        REQUIRE( counter.live == 0 );
+    }
+
+    SECTION( "default resource" ) {
+        memory_resource* previous = set_default_resource(&counter);
+        {
+            const BigInt i("4537141817592417305560");
+            REQUIRE( i.resource() == &counter );
+        }
+        REQUIRE( set_default_resource(previous) == &counter );
+        REQUIRE( counter.allocations > 0 );
+        REQUIRE( counter.live == 0 );
+    }
+
+    SECTION( "buffers of other modules" ) {
+        memory_resource* previous = set_default_resource(&counter);
+        {
+            // a copied MontgomeryContext allocates the modulus and R^2 mod m
+            const MontgomeryContext ctx((BigInt(1) << 127) - 1);
+            const int allocations = counter.allocations;
+            const MontgomeryContext copy = ctx;
+            REQUIRE( counter.allocations == allocations + 2 );
+        }
+        set_default_resource(previous);
+        REQUIRE( counter.live == 0 );
+
+        {
+            const BigInt i("4537141817592417305560");
+            const int allocations = counter.allocations;
+            BigIntAccumulator acc(&counter);
+            acc += i;
+            acc -= i;
+            REQUIRE( counter.allocations == allocations + 2 );
+        }
+        REQUIRE( counter.live == 0 );
+    }
+
+}
+
+TEST_CASE( "monotonic_buffer_resource", "[memory]" ) {
+
+    counting_resource counter;
+
+    SECTION( "initial buffer" ) {
+        alignas(memory_resource::max_align) char buffer[1024];
+        monotonic_buffer_resource arena(buffer, sizeof(buffer), &counter);
+
+        const BigInt i(1234567890123456789, &arena);
+        REQUIRE( (i * i) / i == i );
+        REQUIRE( counter.allocations == 0 );
+    }
+
+    SECTION( "release" ) {
+        monotonic_buffer_resource arena(&counter);
+
+        BigInt i(1, &arena);
+        for (int idx = 0; idx < 100; ++idx)
+            i = i * 1000000007;
+        REQUIRE( i / 1000000007 != 0 );
+        REQUIRE( counter.live > 0 );
+
+        arena.release();
+        REQUIRE( counter.live == 0 );
+    }
+
+}
+
+TEST_CASE( "pool_resource", "[memory]" ) {
+
+    counting_resource counter;
+    pool_resource pool(&counter);
+
+    void* p1 = pool.allocate(24);
+    pool.deallocate(p1, 24);
+    void* p2 = pool.allocate(30);
+    REQUIRE( p1 == p2 ); // recycled from the same size class
+    pool.deallocate(p2, 30);
+
+    int allocations = 0;
+    for (int idx = 0; idx < 10; ++idx)
+    {
+        const BigInt i(1234567890123456789, &pool);
+        REQUIRE( (i * i) / i == i );
+        if (idx == 0)
+            allocations = counter.allocations;
+    }
+    REQUIRE( counter.allocations == allocations ); // no new chunks after warm up
+
+    void* large = pool.allocate(1 << 20);
+    REQUIRE( counter.live > 0 );
+    pool.release();
+    REQUIRE( counter.live == 0 );
+    (void) large;
+}
+
+TEST_CASE( "scratch_buffer", "[memory]" ) {
+
+    mpn::limb_t* first;
+    {
+        const scratch_buffer buffer(100);
+        first = buffer.data();
+        first[99] = 1; // at least 100 limbs
+    }
+
+    // reused by the next request of the same size class
+    const scratch_buffer buffer(120);
+    REQUIRE( buffer.data() == first );
+
+    // nested requests get distinct buffers
+    const scratch_buffer nested(120);
+    REQUIRE( nested.data() != first );
+}
+
+// counting memory functions
+static int hook_allocations = 0;
+static int hook_reallocations = 0;
+static int hook_frees = 0;
+
+static void* counting_allocate(size_t bytes)
+{
+    ++hook_allocations;
+    return ::operator new(bytes);
+}
+
+static void* counting_reallocate(void* p, size_t old_bytes, size_t new_bytes)
+{
+    ++hook_reallocations;
+    void* result = ::operator new(new_bytes);
+    std::memcpy(result, p, std::min(old_bytes, new_bytes));
+    ::operator delete(p);
+    return result;
+}
+
+static void counting_free(void* p, size_t)
+{
+    ++hook_frees;
+    ::operator delete(p);
+}
+
+TEST_CASE( "set_memory_functions", "[memory]" ) {
+
+    allocate_function allocate;
+    reallocate_function reallocate;
+    free_function free;
+    get_memory_functions(&allocate, &reallocate, &free);
+
+    set_memory_functions(counting_allocate, counting_reallocate, counting_free);
+    {
+        const BigInt i1("4537141817592417305560");
+        const BigInt i2 = i1 * i1 * i1;
+        REQUIRE( hook_allocations > 0 );
+        REQUIRE( i2 / i1 == i1 * i1 );
+    }
+    {
+        // a larger scratch buffer replaces a cached smaller one without copying it
+        const scratch_buffer small(1000);
+    }
+    const int frees = hook_frees;
+    {
+        const scratch_buffer large(5000);
+    }
+    REQUIRE( hook_frees == frees + 1 );
+    REQUIRE( hook_reallocations == 0 );
+
+    // restore the previous functions (compatible, since all of them use operator new and delete)
+    set_memory_functions(allocate, reallocate, free);
+    allocate_function restored;
+    get_memory_functions(&restored, nullptr, nullptr);
+    REQUIRE( restored == allocate );
+}
@@ -0,0 +1,126 @@
+#include "catch.hpp"
+#include "../exread/montgomery.hpp"
+
+#include <vector>
+
+using namespace exread;
+
+// a mod m in [0, m)
+static BigInt mod(const BigInt& a, const BigInt& m)
+{
+    const BigInt res = a % m;
+    return res.is_negative() ? res + m : res;
+}
+
+TEST_CASE( "MontgomeryContext", "[montgomery]" ) {
+
+    const BigInt m1("170141183460469231731687303715884105727"); // 2^127 - 1
+    const BigInt m2 = 65521;
+    const BigInt m3 = (BigInt(1) << 160) - 1;
+    const BigInt m4 = 1;
+
+    const BigInt a("98765432109876543210987654321098765432109876543210");
+    const BigInt b("-1234567890123456789012345678901234567890");
+
+    for (const BigInt& m : {m1, m2, m3, m4})
+    {
+        const MontgomeryContext ctx(m);
+        REQUIRE( ctx.modulus() == m );
+        REQUIRE( ctx.size() == m.size() );
+
+        const BigInt am = ctx.to_montgomery(a);
+        const BigInt bm = ctx.to_montgomery(b);
+        REQUIRE( am < m );
+        REQUIRE( ctx.from_montgomery(am) == mod(a, m) );
+        REQUIRE( ctx.from_montgomery(bm) == mod(b, m) );
+
+        REQUIRE( ctx.from_montgomery(ctx.mul(am, bm)) == mod(a * b, m) );
+        REQUIRE( ctx.from_montgomery(ctx.sqr(am)) == mod(a * a, m) );
+        REQUIRE( ctx.sqr(bm) == ctx.mul(bm, bm) );
+
+        // maximal operands
+        const BigInt top = ctx.to_montgomery(m - 1);
+        REQUIRE( ctx.from_montgomery(ctx.mul(top, top)) == mod(1, m) );
+        REQUIRE( ctx.from_montgomery(ctx.sqr(top)) == mod(1, m) );
+    }
+
+}
+
+TEST_CASE( "MontgomeryContext raw limb interface", "[montgomery]" ) {
+
+    const BigInt m = (BigInt(1) << 255) - 19;
+    const MontgomeryContext ctx(m);
+    const size_t n = ctx.size();
+
+    // repeated squaring of 3 in Montgomery form against BigInt arithmetic
+    std::vector<mpn::limb_t> x(n), scratch(ctx.scratch_size());
+    x[0] = 3;
+    ctx.to_montgomery(x.data(), x.data(), scratch.data());
+
+    BigInt expected = 3;
+    for (int idx = 0; idx < 50; ++idx)
+    {
+        ctx.sqr(x.data(), x.data(), scratch.data());
+        ctx.mul(x.data(), x.data(), x.data(), scratch.data());
+        expected = mod(expected * expected * expected * expected, m);
+    }
+
+    std::vector<mpn::limb_t> res(n);
+    ctx.from_montgomery(res.data(), x.data(), scratch.data());
+    BigInt result;
+    std::copy(res.begin(), res.end(), result.limbs_write(n));
+    result.limbs_finish(n);
+    REQUIRE( result == expected );
+
+}
+
+TEST_CASE( "MontgomeryContext invalid modulus", "[montgomery]" ) {
+
+    REQUIRE_THROWS_AS( MontgomeryContext(BigInt(0)), std::invalid_argument );
+    REQUIRE_THROWS_AS( MontgomeryContext(BigInt(1000)), std::invalid_argument );
+    REQUIRE_THROWS_AS( MontgomeryContext(BigInt(-7)), std::invalid_argument );
+
+}
+
+TEST_CASE( "MontgomeryContext short R^2 mod m", "[montgomery]" ) {
+
+    // R^2 mod m has fewer limbs than m, e.g. R^2 mod 65537 == 1 and R^2 mod 1 == 0
+    const BigInt a("98765432109876543210987654321098765432109876543210");
+    for (const BigInt& m : {BigInt(1), BigInt(3), BigInt(65537), (BigInt(1) << 64) + 1, (BigInt(1) << 160) + 1})
+    {
+        const MontgomeryContext original(m);
+        const MontgomeryContext copy = original; // normalized limb storage without spare capacity
+        MontgomeryContext assigned(BigInt(7));
+        assigned = copy;
+
+        const MontgomeryContext* contexts[] = {&original, &copy, &assigned};
+        for (const MontgomeryContext* ctx : contexts)
+        {
+            const BigInt am = ctx->to_montgomery(a);
+            REQUIRE( am == mod(a << (ctx->size() * mpn::limb_bits), m) );
+            REQUIRE( ctx->from_montgomery(am) == mod(a, m) );
+            REQUIRE( ctx->from_montgomery(ctx->mul(am, am)) == mod(a * a, m) );
+        }
+    }
+
+}
+
+TEST_CASE( "MontgomeryContext operands outside [0, m)", "[montgomery]" ) {
+
+    // any representative of a residue class gives the reduced result, also operands with more limbs than m
+    const BigInt m = (BigInt(1) << 127) - 1;
+    const MontgomeryContext ctx(m);
+    const BigInt a("98765432109876543210987654321098765432109876543210");
+    const BigInt am = ctx.to_montgomery(a);
+
+    for (const BigInt& other : {am + m, am + (m << 200), am - m, am - (m << 300), m + 0})
+    {
+        const BigInt expected = mod(other, m);
+        REQUIRE( ctx.from_montgomery(other) == ctx.from_montgomery(expected) );
+        REQUIRE( ctx.mul(other, am) == ctx.mul(expected, am) );
+        REQUIRE( ctx.mul(am, other) == ctx.mul(am, expected) );
+        REQUIRE( ctx.sqr(other) == ctx.sqr(expected) );
+        REQUIRE( ctx.sqr(other) < m );
+    }
+
+}
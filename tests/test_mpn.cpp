@@ -0,0 +1,178 @@
+#include "catch.hpp"
+#include "../exread/mpn.hpp"
+
+#include <vector>
+
+using namespace exread;
+using mpn::limb_t;
+
+TEST_CASE( "cmp", "[mpn]" ) {
+
+    const std::vector<limb_t> a = {1, 2, 3};
+    const std::vector<limb_t> b = {2, 2, 3};
+    const std::vector<limb_t> c = {0, 0, 0, 1};
+
+    REQUIRE( mpn::cmp(a.data(), b.data(), 3) == -1 );
+    REQUIRE( mpn::cmp(b.data(), a.data(), 3) ==  1 );
+    REQUIRE( mpn::cmp(a.data(), a.data(), 3) ==  0 );
+    REQUIRE( mpn::cmp(c.data(), 4, a.data(), 3) ==  1 );
+    REQUIRE( mpn::cmp(a.data(), 3, c.data(), 4) == -1 );
+
+    REQUIRE( mpn::normalized_size(c.data(), 3) == 0 );
+    REQUIRE( mpn::normalized_size(c.data(), 4) == 4 );
+}
+
+TEST_CASE( "add and sub", "[mpn]" ) {
+
+    const std::vector<limb_t> a = {mpn::limb_mask, mpn::limb_mask, 7};
+    const std::vector<limb_t> b = {1};
+    std::vector<limb_t> r(3);
+
+    SECTION( "carry propagation" ) {
+        REQUIRE( mpn::add(r.data(), a.data(), 3, b.data(), 1) == 0 );
+        REQUIRE( r == std::vector<limb_t>({0, 0, 8}) );
+
+        REQUIRE( mpn::sub(r.data(), r.data(), 3, b.data(), 1) == 0 );
+        REQUIRE( r == a );
+    }
+
+    SECTION( "carry out and borrow out" ) {
+        const std::vector<limb_t> m = {mpn::limb_mask, mpn::limb_mask};
+        REQUIRE( mpn::add_1(r.data(), m.data(), 2, 1) == 1 );
+        REQUIRE( r[0] == 0 );
+        REQUIRE( r[1] == 0 );
+
+        REQUIRE( mpn::sub_1(r.data(), r.data(), 2, 1) == 1 );
+        REQUIRE( r[0] == mpn::limb_mask );
+        REQUIRE( r[1] == mpn::limb_mask );
+
+        REQUIRE( mpn::sub_n(r.data(), b.data(), m.data(), 1) == 1 );
+        REQUIRE( r[0] == 2 );
+    }
+
+}
+
+TEST_CASE( "mul_1, addmul_1, submul_1", "[mpn]" ) {
+
+    const std::vector<limb_t> a = {mpn::limb_mask, mpn::limb_mask};
+    std::vector<limb_t> r(2);
+
+    // (b^2 - 1) * (b - 1) = (b-2) * b^2 + (b-1) * b + 1
+    REQUIRE( mpn::mul_1(r.data(), a.data(), 2, mpn::limb_mask) == mpn::limb_mask - 1 );
+    REQUIRE( r == std::vector<limb_t>({1, mpn::limb_mask}) );
+
+    // r = r + a * (b - 1)
+    REQUIRE( mpn::addmul_1(r.data(), a.data(), 2, mpn::limb_mask) == mpn::limb_mask );
+    REQUIRE( r == std::vector<limb_t>({2, mpn::limb_mask - 1}) );
+
+    // undo both
+    REQUIRE( mpn::submul_1(r.data(), a.data(), 2, mpn::limb_mask) == mpn::limb_mask );
+    REQUIRE( r == std::vector<limb_t>({1, mpn::limb_mask}) );
+}
+
+TEST_CASE( "lshift and rshift", "[mpn]" ) {
+
+    const std::vector<limb_t> a = {0x8001, 0x4003};
+    std::vector<limb_t> r(2);
+
+    REQUIRE( mpn::lshift(r.data(), a.data(), 2, 2) == 1 );
+    REQUIRE( r == std::vector<limb_t>({0x0004, 0x000e}) );
+
+    REQUIRE( mpn::rshift(r.data(), a.data(), 2, 1) == 0x8000 );
+    REQUIRE( r == std::vector<limb_t>({0xc000, 0x2001}) );
+}
+
+TEST_CASE( "mul_basecase, divrem_1, divrem", "[mpn]" ) {
+
+    // pseudo random operands
+    std::vector<limb_t> u(9), v(4);
+    limb_t state = 12345;
+    for (limb_t& limb : u)
+        limb = (state = state * 1103515245u + 12345u) >> 16;
+    for (limb_t& limb : v)
+        limb = (state = state * 1103515245u + 12345u) >> 16;
+    v.back() |= 1;
+
+    SECTION( "divrem_1" ) {
+        std::vector<limb_t> q(9), back(10);
+        const limb_t rem = mpn::divrem_1(q.data(), u.data(), 9, 10007);
+        REQUIRE( rem < 10007 );
+
+        back[9] = mpn::mul_1(back.data(), q.data(), 9, 10007);
+        back[9] += mpn::add_1(back.data(), back.data(), 9, rem);
+        REQUIRE( back[9] == 0 );
+        REQUIRE( mpn::cmp(back.data(), u.data(), 9) == 0 );
+    }
+
+    SECTION( "divrem" ) {
+        std::vector<limb_t> q(6), r(4), scratch(mpn::divrem_scratch_size(9, 4));
+        mpn::divrem(q.data(), r.data(), u.data(), 9, v.data(), 4, scratch.data());
+        REQUIRE( mpn::cmp(r.data(), v.data(), 4) < 0 );
+
+        // q * v + r == u
+        std::vector<limb_t> back(10);
+        mpn::mul_basecase(back.data(), q.data(), 6, v.data(), 4);
+        REQUIRE( mpn::add(back.data(), back.data(), 10, r.data(), 4) == 0 );
+        REQUIRE( back[9] == 0 );
+        REQUIRE( mpn::cmp(back.data(), u.data(), 9) == 0 );
+    }
+
+    SECTION( "divrem with maximal quotient digits" ) {
+        // (b^4 - 1) / (b^2 - 1) == b^2 + 1
+        const std::vector<limb_t> n(4, mpn::limb_mask);
+        const std::vector<limb_t> d(2, mpn::limb_mask);
+        std::vector<limb_t> q(3), r(2), scratch(mpn::divrem_scratch_size(4, 2));
+        mpn::divrem(q.data(), r.data(), n.data(), 4, d.data(), 2, scratch.data());
+        REQUIRE( q == std::vector<limb_t>({1, 0, 1}) );
+        REQUIRE( r == std::vector<limb_t>({0, 0}) );
+    }
+
+}
+
+TEST_CASE( "sqr_basecase", "[mpn]" ) {
+
+    for (size_t n = 1; n < 12; ++n)
+    {
+        std::vector<limb_t> u(n);
+        limb_t state = 54321 + n;
+        for (limb_t& limb : u)
+            limb = (state = state * 1103515245u + 12345u) >> 16;
+        u.back() = mpn::limb_mask; // maximal top limb
+
+        std::vector<limb_t> square(2*n), product(2*n);
+        mpn::sqr_basecase(square.data(), u.data(), n);
+        mpn::mul_basecase(product.data(), u.data(), n, u.data(), n);
+        REQUIRE( square == product );
+    }
+}
+
+TEST_CASE( "mul, sqr", "[mpn]" ) {
+
+    // sizes around the Karatsuba threshold, balanced and unbalanced
+    const size_t t = mpn::karatsuba_threshold;
+    const size_t sizes[][2] = { {t, t}, {2*t+1, 2*t+1}, {5*t, 5*t}, {3*t, t}, {7*t+5, 2*t+3}, {4*t, 3*t-1}, {t+1, 1} };
+
+    for (const auto& size : sizes)
+        for (int fill = 0; fill < 2; ++fill)
+        {
+            const size_t un = size[0], vn = size[1];
+            std::vector<limb_t> u(un), v(vn);
+            limb_t state = 12345 + un + vn;
+            for (limb_t& limb : u)
+                limb = fill ? mpn::limb_mask : (state = state * 1103515245u + 12345u) >> 16;
+            for (limb_t& limb : v)
+                limb = fill ? mpn::limb_mask : (state = state * 1103515245u + 12345u) >> 16;
+
+            std::vector<limb_t> product(un + vn), expected(un + vn);
+            std::vector<limb_t> scratch(mpn::mul_scratch_size(un, vn) + 1);
+            mpn::mul(product.data(), u.data(), un, v.data(), vn, scratch.data());
+            mpn::mul_basecase(expected.data(), u.data(), un, v.data(), vn);
+            REQUIRE( product == expected );
+
+            std::vector<limb_t> square(2*un), square_expected(2*un);
+            scratch.resize(mpn::sqr_scratch_size(un) + 1);
+            mpn::sqr(square.data(), u.data(), un, scratch.data());
+            mpn::sqr_basecase(square_expected.data(), u.data(), un);
+            REQUIRE( square == square_expected );
+        }
+}
@@ -0,0 +1,266 @@
+#include "catch.hpp"
+#include "../exread/numtheory.hpp"
+
+#include <vector>
+
+using namespace exread;
+
+// a mod m in [0, m)
+static BigInt mod(const BigInt& a, const BigInt& m)
+{
+    const BigInt res = a % m;
+    return res.is_negative() ? res + m : res;
+}
+
+// base^exponent mod m by plain square-and-multiply
+static BigInt naive_powmod(BigInt base, unsigned long exponent, const BigInt& m)
+{
+    BigInt res = mod(1, m);
+    base = mod(base, m);
+    for ( ; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+            res = mod(res * base, m);
+        base = mod(base * base, m);
+    }
+    return res;
+}
+
+// Fibonacci numbers F_0, ..., F_n
+static std::vector<BigInt> fibonacci(size_t n)
+{
+    std::vector<BigInt> fib = {0, 1};
+    while (fib.size() <= n)
+        fib.push_back(fib[fib.size()-1] + fib[fib.size()-2]);
+    return fib;
+}
+
+TEST_CASE( "gcd, lcm", "[numtheory]" ) {
+
+    SECTION( "small operands" ) {
+        REQUIRE( gcd(0, 0) == 0 );
+        REQUIRE( gcd(0, -7) == 7 );
+        REQUIRE( gcd(12, 18) == 6 );
+        REQUIRE( gcd(-12, 18) == 6 );
+        REQUIRE( gcd(BigInt(1) << 40, BigInt(3) << 20) == BigInt(1) << 20 );
+        REQUIRE( lcm(4, 6) == 12 );
+        REQUIRE( lcm(-4, 6) == 12 );
+        REQUIRE( lcm(0, 6) == 0 );
+    }
+
+    SECTION( "multi-limb operands" ) {
+        const BigInt a("98765432109876543210987654321098765432109876543210");
+        const BigInt b("1234567890123456789012345678901234567890");
+        const BigInt c("170141183460469231731687303715884105727"); // prime
+        REQUIRE( gcd(a * c, b * c) == gcd(a, b) * c );
+        REQUIRE( gcd(a, b) == 90 );
+        REQUIRE( lcm(a, b) == a / 90 * b );
+        REQUIRE( gcd(c, c * c + 1) == 1 );
+    }
+
+    SECTION( "Fibonacci numbers" ) {
+        // gcd(F_m, F_n) == F_gcd(m, n); consecutive Fibonacci numbers are the worst case of
+        // Euclid's algorithm, and the largest ones exercise the half-gcd
+        const std::vector<BigInt> fib = fibonacci(60000);
+        REQUIRE( gcd(fib[60000], fib[59999]) == 1 );
+        REQUIRE( gcd(fib[60000], fib[45000]) == fib[15000] );
+        REQUIRE( gcd(fib[3000], fib[2000]) == fib[1000] );
+        REQUIRE( lcm(fib[3000], fib[2000]) == fib[3000] / fib[1000] * fib[2000] );
+    }
+
+}
+
+TEST_CASE( "gcdext, invert", "[numtheory]" ) {
+
+    const auto check = [](const BigInt& a, const BigInt& b) {
+        const GcdExtResult res = gcdext(a, b);
+        REQUIRE( res.g == gcd(a, b) );
+        REQUIRE( res.s * a + res.t * b == res.g );
+        if (b != 0 && res.g != 0)
+        {
+            const BigInt bound = (b.is_negative() ? -b : b) / (res.g + res.g);
+            REQUIRE( res.s <= bound );
+            REQUIRE( -res.s <= bound );
+        }
+    };
+
+    SECTION( "small operands" ) {
+        const GcdExtResult res = gcdext(240, 46);
+        REQUIRE( res.g == 2 );
+        REQUIRE( res.s == -9 );
+        REQUIRE( res.t == 47 );
+
+        for (int a : {0, 1, -1, 7, -12, 240})
+            for (int b : {0, 1, -1, 5, -18, 46})
+                check(a, b);
+        REQUIRE( gcdext(0, 0).g == 0 );
+        REQUIRE( gcdext(-5, 0).s == -1 );
+    }
+
+    SECTION( "large operands" ) {
+        const BigInt a("98765432109876543210987654321098765432109876543210");
+        const BigInt b("-1234567890123456789012345678901234567890");
+        check(a, b);
+        check(b, a);
+
+        // Fibonacci numbers on the half-gcd path
+        const std::vector<BigInt> fib = fibonacci(30000);
+        check(fib[30000], fib[29999]);
+        check(fib[30000] * 12345, fib[20000] * 678);
+        check(fib[29999] + 1, -fib[17000]);
+    }
+
+    SECTION( "invert" ) {
+        const BigInt p("170141183460469231731687303715884105727"); // 2^127 - 1
+        const BigInt a("-98765432109876543210987654321");
+        const BigInt inverse = invert(a, p);
+        REQUIRE( inverse >= 0 );
+        REQUIRE( inverse < p );
+        REQUIRE( mod(a * inverse, p) == 1 );
+        REQUIRE( invert(a, -p) == inverse );
+        REQUIRE( invert(3, 1) == 0 );
+        REQUIRE( invert(3, 1000) == 667 );
+
+        REQUIRE_THROWS_AS( invert(6, 1000), std::invalid_argument );
+        REQUIRE_THROWS_AS( invert(3, 0), std::invalid_argument );
+    }
+
+}
+
+TEST_CASE( "isqrt, sqrtrem, iroot", "[numtheory]" ) {
+
+    const BigInt x("98765432109876543210987654321098765432109876543210");
+
+    SECTION( "square roots" ) {
+        for (int n = 0; n < 200; ++n)
+        {
+            const BigInt root = isqrt(n);
+            REQUIRE( root * root <= n );
+            REQUIRE( (root + 1) * (root + 1) > n );
+        }
+        REQUIRE( isqrt(x * x) == x );
+        REQUIRE( isqrt(x * x - 1) == x - 1 );
+
+        const SqrtRemResult res = sqrtrem(x * x + x + x);
+        REQUIRE( res.root == x );
+        REQUIRE( res.rem == x + x );
+
+        const BigInt big = (BigInt(1) << 20000) / 3;
+        const SqrtRemResult big_res = sqrtrem(big);
+        REQUIRE( big_res.root * big_res.root + big_res.rem == big );
+        REQUIRE( big_res.rem <= big_res.root + big_res.root );
+    }
+
+    SECTION( "k-th roots" ) {
+        for (unsigned k : {3u, 5u, 7u})
+        {
+            BigInt power = 1;
+            for (unsigned idx = 0; idx < k; ++idx)
+                power = power * x;
+            REQUIRE( iroot(power, k) == x );
+            REQUIRE( iroot(power - 1, k) == x - 1 );
+            REQUIRE( iroot(power + 1, k) == x );
+            REQUIRE( iroot(-power + 1, k) == -x + 1 );
+        }
+        REQUIRE( iroot(x, 1) == x );
+        REQUIRE( iroot(x, 2) == isqrt(x) );
+        REQUIRE( iroot(x, 200) == 1 );
+        REQUIRE( iroot(-27, 3) == -3 );
+        REQUIRE( iroot(0, 4) == 0 );
+    }
+
+    SECTION( "invalid arguments" ) {
+        REQUIRE_THROWS_AS( isqrt(-1), std::invalid_argument );
+        REQUIRE_THROWS_AS( sqrtrem(-1), std::invalid_argument );
+        REQUIRE_THROWS_AS( iroot(8, 0), std::invalid_argument );
+        REQUIRE_THROWS_AS( iroot(-16, 4), std::invalid_argument );
+    }
+
+}
+
+TEST_CASE( "is_perfect_square", "[numtheory]" ) {
+
+    for (int n = -10; n < 1000; ++n)
+    {
+        bool square = false;
+        for (int root = 0; root * root <= n; ++root)
+            square = square || root * root == n;
+        REQUIRE( is_perfect_square(n) == square );
+    }
+
+    const BigInt x("98765432109876543210987654321098765432109876543210");
+    REQUIRE( is_perfect_square(x * x) );
+    REQUIRE( !is_perfect_square(x * x + 1) );
+    REQUIRE( !is_perfect_square(x * x - 1) );
+    REQUIRE( !is_perfect_square(-(x * x)) );
+
+}
+
+TEST_CASE( "powmod", "[numtheory]" ) {
+
+    const BigInt odd("170141183460469231731687303715884105727"); // 2^127 - 1
+    const BigInt even("340282366920938463463374607431768211456000"); // 1000 * 2^128
+    const BigInt base("-98765432109876543210987654321");
+
+    SECTION( "small exponents" ) {
+        for (const BigInt& m : {odd, even, BigInt(65521), BigInt(2), BigInt(1)})
+            for (unsigned long e : {0ul, 1ul, 2ul, 3ul, 12345ul, 0xFFFFFFFFul})
+                REQUIRE( powmod(base, e, m) == naive_powmod(base, e, m) );
+    }
+
+    SECTION( "Fermat's little theorem" ) {
+        // 2^127 - 1 is prime, exercises the widest windows
+        REQUIRE( powmod(3, odd - 1, odd) == 1 );
+        REQUIRE( powmod(base, odd, odd) == mod(base, odd) );
+        const BigInt p = (BigInt(1) << 521) - 1;
+        REQUIRE( powmod(base, p - 1, p) == 1 );
+    }
+
+    SECTION( "even modulus" ) {
+        const BigInt e = (BigInt(1) << 300) + 12345;
+        REQUIRE( powmod(2, e, BigInt(1) << 128) == 0 );
+        const BigInt r = powmod(6, e, even); // even == 2^131 * 125
+        REQUIRE( mod(r, BigInt(1) << 131) == 0 );
+        REQUIRE( mod(r, 125) == powmod(6, e, 125) );
+        REQUIRE( powmod(3, e, BigInt(1) << 64) == naive_powmod(3, 12345, BigInt(1) << 64) ); // 3^(2^62) == 1 mod 2^64
+    }
+
+    SECTION( "negative modulus" ) {
+        REQUIRE( powmod(base, 65537, -odd) == powmod(base, 65537, odd) );
+    }
+
+    SECTION( "reused Montgomery context" ) {
+        const MontgomeryContext ctx(odd);
+        for (unsigned long e : {5ul, 65537ul, 1234567ul})
+            REQUIRE( powmod(base, e, ctx) == naive_powmod(base, e, odd) );
+    }
+
+    SECTION( "copied Montgomery context" ) {
+        // R^2 mod m has fewer limbs than the modulus
+        for (const BigInt& m : {BigInt(1), BigInt(65537), (BigInt(1) << 64) + 1})
+        {
+            const MontgomeryContext original(m);
+            const MontgomeryContext ctx = original;
+            for (unsigned long e : {0ul, 1ul, 5ul, 65537ul})
+                REQUIRE( powmod(base, e, ctx) == naive_powmod(base, e, m) );
+        }
+    }
+
+    SECTION( "reused Barrett context" ) {
+        const BarrettContext ctx(even);
+        for (unsigned long e : {5ul, 65537ul, 1234567ul})
+            REQUIRE( powmod(base, e, ctx) == naive_powmod(base, e, even) );
+    }
+
+    SECTION( "negative exponents" ) {
+        REQUIRE( powmod(base, -1, odd) == invert(base, odd) );
+        REQUIRE( mod(powmod(base, -12345, odd) * powmod(base, 12345, odd), odd) == 1 );
+        REQUIRE( powmod(7, -3, even) == powmod(invert(7, even), 3, even) );
+    }
+
+    SECTION( "invalid arguments" ) {
+        REQUIRE_THROWS_AS( powmod(base, 5, 0), std::invalid_argument );
+        REQUIRE_THROWS_AS( powmod(6, -1, even), std::invalid_argument );
+    }
+
+}
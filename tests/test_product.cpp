@@ -0,0 +1,72 @@
+#include "catch.hpp"
+#include "../exread/product.hpp"
+
+#include <list>
+#include <vector>
+
+using namespace exread;
+
+// product by repeated multiplication from the left
+static BigInt naive_product(const std::vector<BigInt>& factors)
+{
+    BigInt res = 1;
+    for (const BigInt& factor : factors)
+        res = res * factor;
+    return res;
+}
+
+// 'count' factors of varying sizes and signs
+static std::vector<BigInt> make_factors(size_t count)
+{
+    std::vector<BigInt> factors;
+    BigInt x("4537141817592417305560");
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        x = x * 7 + BigInt(idx);
+        factors.push_back(idx % 3 == 0 ? -(x >> (idx % 50)) : x % (BigInt(1) << (16 * (idx % 20) + 5)));
+    }
+    return factors;
+}
+
+TEST_CASE( "product", "[product]" ) {
+
+    SECTION( "short ranges" ) {
+        const std::vector<BigInt> none;
+        REQUIRE( product(none.begin(), none.end()) == 1 );
+
+        const std::vector<BigInt> one = {BigInt(-5)};
+        REQUIRE( product(one.begin(), one.end()) == -5 );
+
+        const std::list<BigInt> three = {BigInt(2), BigInt(-3), BigInt("4537141817592417305560")};
+        REQUIRE( product(three.begin(), three.end()) == BigInt("-27222850905554503833360") );
+
+        const std::vector<BigInt> with_zero = {BigInt(2), BigInt(0), BigInt(7)};
+        REQUIRE( product(with_zero.begin(), with_zero.end()) == 0 );
+    }
+
+    SECTION( "compared with repeated multiplication" ) {
+        for (size_t count : {5, 17, 100})
+        {
+            const std::vector<BigInt> factors = make_factors(count);
+            REQUIRE( product(factors.begin(), factors.end()) == naive_product(factors) );
+        }
+    }
+
+    SECTION( "parallel subtrees" ) {
+        // far beyond the size at which subtrees are multiplied on other threads
+        const std::vector<BigInt> factors = make_factors(2000);
+        REQUIRE( product(factors.begin(), factors.end()) == naive_product(factors) );
+    }
+
+    SECTION( "result resource" ) {
+        monotonic_buffer_resource arena;
+        std::vector<BigInt> factors;
+        for (const BigInt& factor : make_factors(1000))
+            factors.emplace_back(factor, &arena);
+
+        const BigInt res = product(factors.begin(), factors.end());
+        REQUIRE( res.resource() == &arena );
+        REQUIRE( res == naive_product(make_factors(1000)) );
+    }
+
+}
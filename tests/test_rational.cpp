@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "../exread/rational.hpp"
+
+using namespace exread;
+
+TEST_CASE( "Rational constructors", "[Rational]" ) {
+
+    SECTION( "lowest terms" ) {
+        const Rational r(BigInt(6), BigInt(-4));
+        REQUIRE( r.numerator() == -3 );
+        REQUIRE( r.denominator() == 2 );
+
+        const Rational zero(BigInt(0), BigInt(-7));
+        REQUIRE( zero.numerator() == 0 );
+        REQUIRE( zero.denominator() == 1 );
+
+        REQUIRE( Rational().numerator() == 0 );
+        REQUIRE( Rational(5).denominator() == 1 );
+        REQUIRE( Rational(BigInt("4537141817592417305560")).is_integer() );
+    }
+
+    SECTION( "invalid argument" ) {
+        REQUIRE_THROWS_AS( Rational(BigInt(1), BigInt(0)), std::invalid_argument );
+        REQUIRE_THROWS_WITH( Rational(BigInt(1), BigInt(0)), "Rational: zero denominator" );
+    }
+
+}
+
+TEST_CASE( "Rational arithmetic", "[Rational]" ) {
+
+    const Rational half(BigInt(1), BigInt(2));
+    const Rational third(BigInt(1), BigInt(3));
+    const Rational r1(BigInt("4537141817592417305560"), BigInt("-98765432109876543210987654321"));
+    const Rational r2(BigInt("123456789012345678901234567890"), BigInt("4537141817592417305561"));
+
+    SECTION( "operator +, -" ) {
+        REQUIRE( half + third == Rational(BigInt(5), BigInt(6)) );
+        REQUIRE( half - third == Rational(BigInt(1), BigInt(6)) );
+        REQUIRE( Rational(BigInt(1), BigInt(6)) + Rational(BigInt(1), BigInt(3)) == half ); // common factor of the denominators
+        REQUIRE( Rational(BigInt(1), BigInt(6)) + Rational(BigInt(5), BigInt(6)) == 1 );
+        REQUIRE( (half - half).denominator() == 1 );
+        REQUIRE( r1 + r2 - r2 == r1 );
+        REQUIRE( -r1 + r1 == 0 );
+        REQUIRE( half + 2 == Rational(BigInt(5), BigInt(2)) );
+    }
+
+    SECTION( "operator *, /" ) {
+        REQUIRE( half * third == Rational(BigInt(1), BigInt(6)) );
+        REQUIRE( Rational(BigInt(2), BigInt(3)) * Rational(BigInt(9), BigInt(4)) == Rational(BigInt(3), BigInt(2)) );
+        REQUIRE( (r1 * 0).denominator() == 1 );
+        REQUIRE( r1 * r1.inverse() == 1 );
+        REQUIRE( r1 / r2 * r2 == r1 );
+        REQUIRE( half / -third == Rational(BigInt(-3), BigInt(2)) );
+        REQUIRE_THROWS_AS( r1 / 0, std::invalid_argument );
+        REQUIRE_THROWS_WITH( r1 / 0, "Division by Rational(0)" );
+    }
+
+    SECTION( "results in lowest terms" ) {
+        // sum_{k=1}^{n} 1/(k(k+1)) == n/(n+1)
+        Rational sum;
+        for (int k = 1; k <= 200; ++k)
+            sum += Rational(BigInt(1), BigInt(k) * (k + 1));
+        REQUIRE( sum.numerator() == 200 );
+        REQUIRE( sum.denominator() == 201 );
+    }
+
+}
+
+TEST_CASE( "Rational comparison", "[Rational]" ) {
+
+    const Rational half(BigInt(1), BigInt(2));
+    const Rational third(BigInt(1), BigInt(3));
+
+    REQUIRE( third < half );
+    REQUIRE( -half < -third );
+    REQUIRE( -half < 0 );
+    REQUIRE( half > 0 );
+    REQUIRE( half <= half );
+    REQUIRE( half != third );
+    REQUIRE( half.compare(third) == 1 );
+    REQUIRE( third.compare(half) == -1 );
+    REQUIRE( Rational(BigInt(-1), BigInt(3)).compare(Rational(BigInt(1), BigInt(3))) == -1 );
+
+}
+
+TEST_CASE( "lazy Rational", "[Rational]" ) {
+
+    SECTION( "reduced on access" ) {
+        Rational sum = Rational().set_lazy();
+        for (int k = 1; k <= 200; ++k)
+            sum += Rational(BigInt(1), BigInt(k) * (k + 1));
+        REQUIRE( sum.is_lazy() );
+        REQUIRE( sum == Rational(BigInt(200), BigInt(201)) ); // compares unreduced
+        REQUIRE( sum.numerator() == 200 );
+        REQUIRE( sum.denominator() == 201 );
+    }
+
+    SECTION( "mixed with eager operands" ) {
+        Rational lazy = Rational(BigInt(2), BigInt(3)).set_lazy();
+        const Rational product = lazy * Rational(BigInt(3), BigInt(4));
+        REQUIRE( product.is_lazy() );
+        REQUIRE( product == Rational(BigInt(1), BigInt(2)) );
+
+        Rational eager = product;
+        eager.set_lazy(false);
+        REQUIRE( !eager.is_lazy() );
+        REQUIRE( eager.numerator() == 1 );
+        REQUIRE( eager.denominator() == 2 );
+        REQUIRE( (lazy - lazy).is_integer() );
+    }
+
+}
@@ -0,0 +1,93 @@
+#include "catch.hpp"
+#include "../exread/real.hpp"
+#include "../exread/numtheory.hpp"
+
+#include <cmath>
+
+using namespace exread;
+
+// |a - b| <= 1
+static bool close(const BigInt& a, const BigInt& b)
+{
+    return (a - b).bit_length() <= 1;
+}
+
+TEST_CASE( "Real exact values", "[Real]" ) {
+
+    REQUIRE( Real().approximate(-100) == 0 );
+    REQUIRE( Real(5).approximate(0) == 5 );
+    REQUIRE( Real(BigInt(-5)).approximate(-3) == -40 );
+    REQUIRE( Real(0.75).approximate(-2) == 3 );
+    REQUIRE( Real(BigFloat(BigInt(3) << 100)).approximate(99) == 6 );
+
+    // 1/3 * 2^10 == 341.33...
+    const Real third(Rational(BigInt(1), BigInt(3)));
+    REQUIRE( third.approximate(-10) == 341 );
+    REQUIRE( (-third).approximate(-10) == -341 );
+    REQUIRE( third.approximate(10) == 0 );
+
+}
+
+TEST_CASE( "Real arithmetic", "[Real]" ) {
+
+    const Real two(2);
+    const Real root2 = sqrt(two);
+
+    SECTION( "square root" ) {
+        REQUIRE( close(root2.approximate(-200), isqrt(BigInt(2) << 400)) );
+        REQUIRE( close(sqrt(Real(1) << 1001).approximate(400), isqrt(BigInt(2) << 200)) );
+        const BigFloat error = root2.to_bigfloat(-52) - BigFloat(std::sqrt(2.0));
+        REQUIRE( error <= BigFloat(std::ldexp(1.0, -52)) );
+        REQUIRE( error >= BigFloat(-std::ldexp(1.0, -52)) );
+        REQUIRE_THROWS_AS( sqrt(Real(-1)).approximate(0), std::invalid_argument );
+    }
+
+    SECTION( "operators" ) {
+        REQUIRE( (root2 * root2 - two).approximate(-500).bit_length() <= 1 );
+        REQUIRE( close((root2 / two).approximate(-300), isqrt(BigInt(1) << 599)) );
+        REQUIRE( (two / root2).compare(root2, -400) == 0 );
+        REQUIRE( close((root2 + Real(1)).approximate(-100), isqrt(BigInt(2) << 200) + (BigInt(1) << 100)) );
+        REQUIRE( close((root2 >> 3).approximate(-10), ((root2 << 3).approximate(-16) + 2048) >> 12) );
+
+        // the golden ratio solves phi^2 == phi + 1
+        const Real phi = (Real(1) + sqrt(Real(5))) >> 1;
+        REQUIRE( (phi * phi - phi - Real(1)).approximate(-1000).bit_length() <= 1 );
+        REQUIRE( close(phi.inverse().approximate(-200), (phi - Real(1)).approximate(-200)) );
+    }
+
+    SECTION( "cancellation and tiny values" ) {
+        // only 2^-500 remains of x + 2^-500 - x, and its inverse is 2^500
+        const Real tiny = Real(1) >> 500;
+        REQUIRE( close((root2 + tiny - root2).approximate(-600), BigInt(1) << 100) );
+        REQUIRE( close((root2 + tiny - root2).inverse().approximate(400), BigInt(1) << 100) );
+        REQUIRE( (tiny * tiny).approximate(-900) == 0 );
+        REQUIRE( close((tiny * (Real(1) << 800)).approximate(0), BigInt(1) << 300) );
+    }
+
+}
+
+TEST_CASE( "Real comparison", "[Real]" ) {
+
+    const Real root2 = sqrt(Real(2));
+    const Real approx(Rational(BigInt(14142), BigInt(10000)));
+    REQUIRE( root2.compare(approx, -20) == 1 );
+    REQUIRE( approx.compare(root2, -20) == -1 );
+    REQUIRE( root2.compare(approx, 0) == 0 );
+    REQUIRE( (root2 * root2).compare(Real(2), -1000) == 0 );
+
+}
+
+TEST_CASE( "Real refinement", "[Real]" ) {
+
+    // successively finer approximations are consistent with each other
+    const Real x = sqrt(Real(3)) * Real(Rational(BigInt(-7), BigInt(11))) + sqrt(Real(2)).inverse();
+    BigInt previous = x.approximate(0);
+    for (long p = -16; p >= -4000; p -= 16)
+    {
+        const BigInt a = x.approximate(p);
+        REQUIRE( (a - (previous << 16)).bit_length() <= 17 );
+        previous = a;
+    }
+    REQUIRE( close(x.approximate(-2000), x.approximate(-4000) >> 2000) );
+
+}